@@ -1,29 +1,137 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <array>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace Exercise
 {
     enum class Implementation {
         Generic,
-        Optimized
+        Optimized, // memmove
+        Unrolled
     };
 
+    // contiguous ranges of the same trivially copyable type - can be copied as raw bytes
     template <typename InputIterator, typename OutputIterator>
-    Implementation copy(InputIterator start, InputIterator end, OutputIterator dest)
+    concept MemmoveCopyable = std::contiguous_iterator<InputIterator>
+        && std::contiguous_iterator<OutputIterator>
+        && std::is_same_v<std::iter_value_t<InputIterator>, std::iter_value_t<OutputIterator>>
+        && std::is_trivially_copyable_v<std::iter_value_t<InputIterator>>
+        && std::is_assignable_v<std::iter_reference_t<OutputIterator>, std::iter_reference_t<InputIterator>>;
+
+    // contiguous ranges of types that are not trivially copyable, but cheap (nothrow) to copy-assign
+    template <typename InputIterator, typename OutputIterator>
+    concept UnrolledCopyable = std::contiguous_iterator<InputIterator>
+        && std::contiguous_iterator<OutputIterator>
+        && !MemmoveCopyable<InputIterator, OutputIterator>
+        && std::is_nothrow_assignable_v<std::iter_reference_t<OutputIterator>, std::iter_reference_t<InputIterator>>;
+
+    namespace Impl
     {
-        for (auto it = start; it != end; ++it, ++dest)
+        template <typename InputIterator, typename OutputIterator>
+        void generic_copy(InputIterator start, InputIterator end, OutputIterator dest)
+        {
+            for (auto it = start; it != end; ++it, ++dest)
+            {
+                *dest = *it;
+            }
+        }
+
+        template <typename InputIterator, typename OutputIterator>
+        void memmove_copy(InputIterator start, InputIterator end, OutputIterator dest)
         {
-            *dest = *it;
+            using T = std::iter_value_t<InputIterator>;
+
+            const auto count = end - start;
+            if (count > 0)
+                std::memmove(std::to_address(dest), std::to_address(start), count * sizeof(T));
         }
 
+        template <typename InputIterator, typename OutputIterator>
+        void unrolled_copy(InputIterator start, InputIterator end, OutputIterator dest)
+        {
+            const auto* src = std::to_address(start);
+            auto* dst = std::to_address(dest);
+            const std::size_t count = end - start;
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                dst[i] = src[i];
+                dst[i + 1] = src[i + 1];
+                dst[i + 2] = src[i + 2];
+                dst[i + 3] = src[i + 3];
+            }
+
+            for (; i < count; ++i)
+                dst[i] = src[i];
+        }
+    } // namespace Impl
+
+    template <typename InputIterator, typename OutputIterator>
+    auto copy(InputIterator start, InputIterator end, OutputIterator dest)
+        -> std::enable_if_t<MemmoveCopyable<InputIterator, OutputIterator>, Implementation>
+    {
+        Impl::memmove_copy(start, end, dest);
+
+        return Implementation::Optimized;
+    }
+
+    template <typename InputIterator, typename OutputIterator>
+    auto copy(InputIterator start, InputIterator end, OutputIterator dest)
+        -> std::enable_if_t<UnrolledCopyable<InputIterator, OutputIterator>, Implementation>
+    {
+        Impl::unrolled_copy(start, end, dest);
+
+        return Implementation::Unrolled;
+    }
+
+    template <typename InputIterator, typename OutputIterator>
+    auto copy(InputIterator start, InputIterator end, OutputIterator dest)
+        -> std::enable_if_t<!MemmoveCopyable<InputIterator, OutputIterator> && !UnrolledCopyable<InputIterator, OutputIterator>, Implementation>
+    {
+        Impl::generic_copy(start, end, dest);
+
         return Implementation::Generic;
     }
 } // namespace Exercise
 
-// TODO - optimized version with memcpy of copy
+namespace
+{
+    // not trivially copyable, but copy-assignment is cheap & noexcept
+    struct Point
+    {
+        int x{}, y{};
+
+        Point() = default;
+
+        Point(int x, int y)
+            : x{x}
+            , y{y}
+        {
+        }
+
+        Point(const Point&) = default;
+
+        Point& operator=(const Point& other) noexcept
+        {
+            x = other.x;
+            y = other.y;
+            return *this;
+        }
+
+        bool operator==(const Point&) const = default;
+    };
+
+    static_assert(!std::is_trivially_copyable_v<Point>);
+}
 
 TEST_CASE("copy algorithm")
 {
@@ -48,12 +156,97 @@ TEST_CASE("copy algorithm")
         REQUIRE(std::equal(begin(words), end(words), begin(dest), end(dest)));
     }
 
-    // SECTION("optimized for arrays of POD types")
-    // {
-    //     int tab1[5] = {1, 2, 3, 4, 5};
-    //     int tab2[5];
+    SECTION("optimized for arrays of POD types")
+    {
+        int tab1[5] = {1, 2, 3, 4, 5};
+        int tab2[5];
+
+        REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
+        REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
+    }
+
+    SECTION("optimized for contiguous containers of trivially copyable types")
+    {
+        const std::vector<double> vec = {1.0, 2.0, 3.0};
+        std::array<double, 3> arr{};
+
+        REQUIRE(Exercise::copy(vec.begin(), vec.end(), arr.begin()) == Implementation::Optimized);
+        REQUIRE(std::equal(vec.begin(), vec.end(), arr.begin(), arr.end()));
+
+        std::vector<double> target(3);
+        REQUIRE(Exercise::copy(arr.cbegin(), arr.cend(), target.data()) == Implementation::Optimized);
+        REQUIRE(target == vec);
+    }
+
+    SECTION("optimized copy of an empty range")
+    {
+        std::vector<int> empty;
+        int tab[1] = {42};
 
-    //     REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
-    //     REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
-    // }
+        REQUIRE(Exercise::copy(empty.begin(), empty.end(), begin(tab)) == Implementation::Optimized);
+        REQUIRE(tab[0] == 42);
+    }
+
+    SECTION("unrolled for contiguous ranges of cheap non-trivial types")
+    {
+        std::vector<Point> points = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}};
+        std::vector<Point> target(points.size());
+
+        REQUIRE(Exercise::copy(points.begin(), points.end(), target.begin()) == Implementation::Unrolled);
+        REQUIRE(target == points);
+    }
+
+    SECTION("unrolled for conversions between contiguous ranges")
+    {
+        const int ints[] = {1, 2, 3};
+        long longs[3];
+
+        REQUIRE(Exercise::copy(begin(ints), end(ints), begin(longs)) == Implementation::Unrolled);
+        REQUIRE(std::equal(begin(ints), end(ints), begin(longs), end(longs)));
+    }
+
+    SECTION("generic for output iterators")
+    {
+        std::vector<int> vec = {1, 2, 3};
+        std::vector<int> target;
+
+        REQUIRE(Exercise::copy(vec.begin(), vec.end(), std::back_inserter(target)) == Implementation::Generic);
+        REQUIRE(target == vec);
+    }
+}
+
+TEST_CASE("Exercise::copy - dispatch", "[.][benchmark]")
+{
+    for (std::size_t size : {16u, 1'024u, 64u * 1'024u, 1'024u * 1'024u})
+    {
+        const std::string suffix = " - size: " + std::to_string(size);
+
+        const std::vector<int> ints(size, 42);
+        std::vector<int> int_target(size);
+
+        BENCHMARK("int - generic loop" + suffix)
+        {
+            Exercise::Impl::generic_copy(ints.begin(), ints.end(), int_target.begin());
+            return int_target.back();
+        };
+
+        BENCHMARK("int - Exercise::copy" + suffix)
+        {
+            return Exercise::copy(ints.begin(), ints.end(), int_target.begin());
+        };
+
+        const std::vector<Point> points(size, Point{1, 2});
+        std::vector<Point> point_target(size);
+
+        BENCHMARK("Point - generic loop" + suffix)
+        {
+            Exercise::Impl::generic_copy(points.begin(), points.end(), point_target.begin());
+            return point_target.back().x;
+        };
+
+        BENCHMARK("Point - Exercise::copy" + suffix)
+        {
+            return Exercise::copy(points.begin(), points.end(), point_target.begin());
+        };
+    }
 }
\ No newline at end of file
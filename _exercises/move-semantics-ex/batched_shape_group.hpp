@@ -0,0 +1,74 @@
+#ifndef BATCHED_SHAPE_GROUP_HPP_
+#define BATCHED_SHAPE_GROUP_HPP_
+
+#include "paragraph.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Alternative to ShapeGroup - shapes of every concrete type are stored by value
+// in their own contiguous array & drawn in one pass per type
+// (no pointer chasing, no virtual dispatch inside a pass)
+template <typename... TShapes>
+class BatchedShapeGroup : public Shape
+{
+    static_assert((std::is_base_of_v<Shape, TShapes> && ...), "Only shapes can be stored in a group");
+
+    std::tuple<std::vector<TShapes>...> batches_;
+
+    template <typename TShape>
+    static void draw_batch(const std::vector<TShape>& batch, RenderSink& sink)
+    {
+        for (const TShape& shape : batch)
+            shape.TShape::draw(sink); // qualified call - dispatched statically
+    }
+
+public:
+    BatchedShapeGroup() = default;
+
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
+    {
+        std::apply([&sink](const auto&... batch) { (draw_batch(batch, sink), ...); }, batches_);
+    }
+
+    template <typename TShape>
+    void add(TShape&& shape)
+    {
+        batch<std::decay_t<TShape>>().push_back(std::forward<TShape>(shape));
+    }
+
+    template <typename TShape, typename... TArgs>
+    TShape& emplace(TArgs&&... args)
+    {
+        return batch<TShape>().emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    template <typename TShape>
+    void reserve(size_t count)
+    {
+        batch<TShape>().reserve(count);
+    }
+
+    template <typename TShape>
+    std::vector<TShape>& batch()
+    {
+        return std::get<std::vector<TShape>>(batches_);
+    }
+
+    template <typename TShape>
+    const std::vector<TShape>& batch() const
+    {
+        return std::get<std::vector<TShape>>(batches_);
+    }
+
+    size_t size() const
+    {
+        return std::apply([](const auto&... batch) { return (batch.size() + ... + size_t{}); }, batches_);
+    }
+};
+
+#endif /*BATCHED_SHAPE_GROUP_HPP_*/
@@ -0,0 +1,22 @@
+#ifndef NULL_BUFFER_HPP_
+#define NULL_BUFFER_HPP_
+
+#include <ios>
+#include <streambuf>
+
+// stream buffer that discards everything written to it
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override
+    {
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override
+    {
+        return count;
+    }
+};
+
+#endif
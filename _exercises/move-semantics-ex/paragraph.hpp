@@ -6,53 +6,124 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
 #include <utility>
 
+#include "render_sink.hpp"
+
 namespace LegacyCode
 {
     class Paragraph
     {
-        char* buffer_;
+    public:
+        static constexpr std::size_t inline_capacity = 15;
+
+    private:
+        char* buffer_;            // points to inline_buffer_ or to a heap buffer; nullptr after move
+        std::size_t capacity_{};  // max length of text that fits in buffer_
+        std::pmr::memory_resource* resource_{std::pmr::get_default_resource()}; // source of a heap buffer
+        char inline_buffer_[inline_capacity + 1];
+
+        bool is_inline() const noexcept
+        {
+            return buffer_ == inline_buffer_;
+        }
+
+        void release() noexcept
+        {
+            if (buffer_ != nullptr && !is_inline())
+                resource_->deallocate(buffer_, capacity_ + 1, alignof(char));
+
+            buffer_ = nullptr;
+            capacity_ = 0;
+        }
+
+        // expects that *this owns no heap buffer - the memory resource travels with the buffer
+        void take(Paragraph& other) noexcept
+        {
+            resource_ = other.resource_;
+
+            if (other.is_inline())
+            {
+                std::memcpy(inline_buffer_, other.inline_buffer_, sizeof(inline_buffer_));
+                buffer_ = inline_buffer_;
+            }
+            else
+            {
+                buffer_ = other.buffer_;
+            }
+
+            capacity_ = std::exchange(other.capacity_, 0);
+            other.buffer_ = nullptr;
+        }
+
+        // copies txt to a buffer sized exactly to its length (or to the inline buffer)
+        void assign(const char* txt)
+        {
+            const std::size_t length = std::strlen(txt);
+
+            if (buffer_ == nullptr || length > capacity_)
+            {
+                char* new_buffer = (length <= inline_capacity)
+                                       ? inline_buffer_
+                                       : static_cast<char*>(resource_->allocate(length + 1, alignof(char)));
+                release();
+                buffer_ = new_buffer;
+                capacity_ = (buffer_ == inline_buffer_) ? inline_capacity : length;
+            }
+
+            std::memcpy(buffer_, txt, length + 1);
+        }
 
     protected:
         void swap(Paragraph& p) noexcept
         {
-            std::swap(buffer_, p.buffer_);
+            Paragraph temp = std::move(p);
+            p.take(*this);
+            take(temp);
         }
 
     public:
         Paragraph()
-            : buffer_(new char[1024])
+            : Paragraph("Default text!")
         {
-            std::strcpy(buffer_, "Default text!");
         }
 
         Paragraph(const Paragraph& p)
-            : buffer_(new char[1024])
+            : buffer_{nullptr}
         {
-            std::strcpy(buffer_, p.buffer_);
+            if (p.buffer_ != nullptr)
+                assign(p.buffer_);
         }
 
         Paragraph(const char* txt)
-            : buffer_(new char[1024])
+            : buffer_{nullptr}
+        {
+            assign(txt);
+        }
+
+        // long texts are allocated from resource (e.g. an arena of ShapeGroup)
+        Paragraph(const char* txt, std::pmr::memory_resource* resource)
+            : buffer_{nullptr}
+            , resource_{resource}
         {
-            std::strcpy(buffer_, txt);
+            assign(txt);
         }
 
-        Paragraph(Paragraph&& other) noexcept 
-            : buffer_(std::exchange(other.buffer_, nullptr))
-        {    
+        Paragraph(Paragraph&& other) noexcept
+            : buffer_{nullptr}
+        {
+            take(other);
         }
 
         Paragraph& operator=(Paragraph&& other) noexcept
         {
             if (this != &other)
             {
-                // delete[] buffer_;
-                // buffer_ = std::exchange(other.buffer_, nullptr);
-
-                Paragraph temp = std::move(other);
-                swap(temp);
+                release();
+                take(other);
             }
             return *this;
         }
@@ -67,7 +138,7 @@ namespace LegacyCode
 
         void set_paragraph(const char* txt)
         {
-            std::strcpy(buffer_, txt);
+            assign(txt);
         }
 
         const char* get_paragraph() const noexcept
@@ -75,23 +146,49 @@ namespace LegacyCode
             return buffer_;
         }
 
+        // bytes allocated on the heap for the text (0 if it is stored inline)
+        std::size_t heap_size() const noexcept
+        {
+            return (buffer_ == nullptr || is_inline()) ? 0 : capacity_ + 1;
+        }
+
         void render_at(int posx, int posy) const
         {
-            std::cout << "Rendering text '" << buffer_ << "' at: [" << posx << ", " << posy << "]" << std::endl;
+            StreamSink sink{std::cout};
+            render_at(sink, posx, posy);
+        }
+
+        void render_at(RenderSink& sink, int posx, int posy) const
+        {
+            sink.render_text(buffer_, posx, posy);
         }
 
         ~Paragraph() noexcept
         {
-            delete[] buffer_;
+            release();
         }
     };
 }
 
+struct ShapeGroup;
+
 class Shape
 {
 public:
     virtual ~Shape() = default;
-    virtual void draw() const = 0;
+    virtual void draw(RenderSink& sink) const = 0;
+
+    // cheaper than dynamic_cast when a traversal has to descend into groups
+    virtual const ShapeGroup* as_group() const noexcept
+    {
+        return nullptr;
+    }
+
+    void draw() const
+    {
+        StreamSink sink{std::cout};
+        draw(sink);
+    }
 };
 
 class Text : public Shape
@@ -107,9 +204,18 @@ public:
     {
     }
 
-    void draw() const override
+    Text(int x, int y, const std::string& text, std::pmr::memory_resource* resource)
+        : x_{x}
+        , y_{y}
+        , p_{text.c_str(), resource}
     {
-        p_.render_at(x_, y_);
+    }
+
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
+    {
+        p_.render_at(sink, x_, y_);
     }
 
     std::string text() const
@@ -122,24 +228,120 @@ public:
     {
         p_.set_paragraph(text.c_str());
     }
+
+    // bytes owned by the shape (object + heap buffer of a paragraph)
+    std::size_t memory_footprint() const noexcept
+    {
+        return sizeof(*this) + p_.heap_size();
+    }
 };
 
+////////////////////////////////////////////////////////////////
+// deletes shapes allocated with new; only destroys shapes placed in an arena of ShapeGroup
+struct ShapeDeleter
+{
+    bool in_arena = false;
+
+    ShapeDeleter() = default;
+
+    explicit ShapeDeleter(bool in_arena) noexcept
+        : in_arena{in_arena}
+    {
+    }
+
+    template <typename TShape>
+    ShapeDeleter(std::default_delete<TShape>) noexcept
+    {
+    }
+
+    void operator()(Shape* shape) const noexcept
+    {
+        if (in_arena)
+            std::destroy_at(shape);
+        else
+            delete shape;
+    }
+};
+
+using ShapePtr = std::unique_ptr<Shape, ShapeDeleter>;
+
 struct ShapeGroup : public Shape
 {
-    std::vector<std::unique_ptr<Shape>> shapes;
+private:
+    // declared before shapes - the arena is released after all shapes are destroyed
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+
+public:
+    std::vector<ShapePtr> shapes;
 
     ShapeGroup() = default;
 
-    void draw() const override
+    // shapes created with emplace() (and their texts) are allocated from a monotonic arena
+    // released in bulk when the group is destroyed
+    explicit ShapeGroup(std::size_t arena_initial_size,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : arena_{std::make_unique<std::pmr::monotonic_buffer_resource>(arena_initial_size, upstream)}
+    {
+    }
+
+    ShapeGroup(ShapeGroup&&) = default;
+
+    ShapeGroup& operator=(ShapeGroup&& other) noexcept
+    {
+        if (this != &other)
+        {
+            shapes.clear(); // shapes must be destroyed before their arena
+            arena_ = std::move(other.arena_);
+            shapes = std::move(other.shapes);
+        }
+
+        return *this;
+    }
+
+    bool has_arena() const noexcept
+    {
+        return arena_ != nullptr;
+    }
+
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
     {
         for (const auto& s : shapes)
-            s->draw();
+            s->draw(sink);
+    }
+
+    const ShapeGroup* as_group() const noexcept override
+    {
+        return this;
     }
 
-    void add(std::unique_ptr<Shape> shape)
+    void add(ShapePtr shape)
     {
         shapes.push_back(std::move(shape));
     }
+
+    template <typename TShape, typename... TArgs>
+    TShape& emplace(TArgs&&... args)
+    {
+        if (!arena_)
+        {
+            auto shape = std::make_unique<TShape>(std::forward<TArgs>(args)...);
+            TShape& result = *shape;
+            add(std::move(shape));
+            return result;
+        }
+
+        void* raw_memory = arena_->allocate(sizeof(TShape), alignof(TShape));
+        TShape* shape;
+        if constexpr (std::is_constructible_v<TShape, TArgs..., std::pmr::memory_resource*>)
+            shape = ::new (raw_memory) TShape(std::forward<TArgs>(args)..., arena_.get());
+        else
+            shape = ::new (raw_memory) TShape(std::forward<TArgs>(args)...);
+
+        add(ShapePtr{shape, ShapeDeleter{true}});
+        return *shape;
+    }
 };
 
 #endif /*PARAGRAPH_HPP_*/
@@ -0,0 +1,100 @@
+#ifndef PARALLEL_DRAW_HPP_
+#define PARALLEL_DRAW_HPP_
+
+#include "paragraph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Parallel
+{
+    // contiguous range of children of a group - drawn by one worker
+    struct DrawTask
+    {
+        const ShapeGroup* group;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // splits a tree into tasks listed in the order of a serial draw();
+    // nested groups are descended into, so one large subgroup does not become a single task
+    inline void collect_tasks(const ShapeGroup& group, std::size_t grain_size, std::vector<DrawTask>& tasks)
+    {
+        const auto add_range = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t first = begin; first < end; first += grain_size)
+                tasks.push_back(DrawTask{&group, first, std::min(first + grain_size, end)});
+        };
+
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < group.shapes.size(); ++i)
+        {
+            if (const ShapeGroup* subgroup = group.shapes[i]->as_group())
+            {
+                add_range(begin, i);
+                collect_tasks(*subgroup, grain_size, tasks);
+                begin = i + 1;
+            }
+        }
+        add_range(begin, group.shapes.size());
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // draws a tree on thread_count threads - workers pick tasks dynamically & render
+    // into per-task string sinks; outputs are written to out in task order, so the result
+    // is byte-identical to group.draw(StreamSink{out})
+    inline void draw(const ShapeGroup& group, std::ostream& out,
+                     unsigned thread_count = std::max(1u, std::thread::hardware_concurrency()),
+                     std::size_t grain_size = 4096)
+    {
+        std::vector<DrawTask> tasks;
+        collect_tasks(group, std::max<std::size_t>(grain_size, 1), tasks);
+
+        std::vector<StringSink> outputs(tasks.size());
+        std::atomic<std::size_t> next_task{0};
+        std::exception_ptr error;
+        std::mutex error_mtx;
+
+        const auto worker = [&] {
+            try
+            {
+                for (std::size_t index = next_task++; index < tasks.size(); index = next_task++)
+                {
+                    const DrawTask& task = tasks[index];
+                    for (std::size_t i = task.begin; i < task.end; ++i)
+                        task.group->shapes[i]->draw(outputs[index]);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lk{error_mtx};
+                if (!error)
+                    error = std::current_exception();
+                next_task = tasks.size(); // stops other workers
+            }
+        };
+
+        {
+            const std::size_t workers_count = std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(tasks.size(), 1));
+
+            std::vector<std::jthread> threads;
+            for (std::size_t i = 1; i < workers_count; ++i)
+                threads.emplace_back(worker);
+
+            worker(); // calling thread works too
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (const StringSink& output : outputs)
+            out.write(output.str().data(), static_cast<std::streamsize>(output.str().size()));
+
+        out.flush();
+    }
+} // namespace Parallel
+
+#endif /*PARALLEL_DRAW_HPP_*/
@@ -0,0 +1,150 @@
+#ifndef RENDER_SINK_HPP_
+#define RENDER_SINK_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// appends a line in the format written by StreamSink
+inline void format_text(std::string& out, std::string_view text, int posx, int posy)
+{
+    const auto append = [&out](int value) {
+        char digits[16];
+        const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, end);
+    };
+
+    out.append("Rendering text '");
+    out.append(text);
+    out.append("' at: [");
+    append(posx);
+    out.append(", ");
+    append(posy);
+    out.append("]\n");
+}
+
+////////////////////////////////////////////////////////////////
+// Target of Shape::draw
+class RenderSink
+{
+public:
+    virtual ~RenderSink() = default;
+    virtual void render_text(std::string_view text, int posx, int posy) = 0;
+    virtual void flush() { }
+};
+
+////////////////////////////////////////////////////////////////
+// writes & flushes every line - behaviour of original Paragraph::render_at
+class StreamSink : public RenderSink
+{
+    std::ostream& out_;
+
+public:
+    explicit StreamSink(std::ostream& out)
+        : out_{out}
+    {
+    }
+
+    void render_text(std::string_view text, int posx, int posy) override
+    {
+        out_ << "Rendering text '" << text << "' at: [" << posx << ", " << posy << "]" << std::endl;
+    }
+
+    void flush() override
+    {
+        out_.flush();
+    }
+};
+
+////////////////////////////////////////////////////////////////
+// formats lines into a reusable buffer & writes it in large chunks
+class BatchedSink : public RenderSink
+{
+    std::ostream& out_;
+    std::string buffer_;
+    std::size_t flush_threshold_;
+
+public:
+    static constexpr std::size_t default_flush_threshold = 64 * 1024;
+
+    explicit BatchedSink(std::ostream& out, std::size_t flush_threshold = default_flush_threshold)
+        : out_{out}
+        , flush_threshold_{flush_threshold}
+    {
+        buffer_.reserve(flush_threshold_ + 256);
+    }
+
+    BatchedSink(const BatchedSink&) = delete;
+    BatchedSink& operator=(const BatchedSink&) = delete;
+
+    ~BatchedSink() override
+    {
+        flush();
+    }
+
+    void render_text(std::string_view text, int posx, int posy) override
+    {
+        format_text(buffer_, text, posx, posy);
+
+        if (buffer_.size() >= flush_threshold_)
+            write_buffer();
+    }
+
+    void flush() override
+    {
+        write_buffer();
+        out_.flush();
+    }
+
+    const std::string& pending() const noexcept
+    {
+        return buffer_;
+    }
+
+private:
+    void write_buffer()
+    {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear(); // capacity is kept
+    }
+};
+
+////////////////////////////////////////////////////////////////
+// formats lines into an in-memory string
+class StringSink : public RenderSink
+{
+    std::string buffer_;
+
+public:
+    void render_text(std::string_view text, int posx, int posy) override
+    {
+        format_text(buffer_, text, posx, posy);
+    }
+
+    const std::string& str() const noexcept
+    {
+        return buffer_;
+    }
+};
+
+////////////////////////////////////////////////////////////////
+// discards the output - measures pure traversal cost
+class NullSink : public RenderSink
+{
+    std::size_t count_{};
+
+public:
+    void render_text(std::string_view, int, int) override
+    {
+        ++count_;
+    }
+
+    std::size_t count() const noexcept
+    {
+        return count_;
+    }
+};
+
+#endif /*RENDER_SINK_HPP_*/
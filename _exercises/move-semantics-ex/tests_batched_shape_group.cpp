@@ -0,0 +1,58 @@
+#include "batched_shape_group.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <sstream>
+
+TEST_CASE("BatchedShapeGroup")
+{
+    BatchedShapeGroup<Text, ShapeGroup> group;
+
+    group.add(Text{1, 2, "one"});
+    group.emplace<Text>(3, 4, "two");
+
+    ShapeGroup nested;
+    nested.add(std::make_unique<Text>(5, 6, "nested"));
+    group.add(std::move(nested));
+
+    REQUIRE(group.size() == 3);
+    REQUIRE(group.batch<Text>().size() == 2);
+    REQUIRE(group.batch<Text>()[1].text() == "two");
+
+    std::ostringstream out;
+    StreamSink sink{out};
+    group.draw(sink);
+
+    REQUIRE(out.str() == "Rendering text 'one' at: [1, 2]\n"
+                         "Rendering text 'two' at: [3, 4]\n"
+                         "Rendering text 'nested' at: [5, 6]\n");
+}
+
+TEST_CASE("ShapeGroup vs. BatchedShapeGroup - draw", "[.][benchmark]")
+{
+    constexpr int count = 1'000'000;
+
+    ShapeGroup pointer_group;
+    pointer_group.shapes.reserve(count);
+    for (int i = 0; i < count; ++i)
+        pointer_group.add(std::make_unique<Text>(i, i, "label"));
+
+    BatchedShapeGroup<Text> batched_group;
+    batched_group.reserve<Text>(count);
+    for (int i = 0; i < count; ++i)
+        batched_group.emplace<Text>(i, i, "label");
+
+    BENCHMARK("ShapeGroup - vector<unique_ptr<Shape>>")
+    {
+        NullSink sink;
+        pointer_group.draw(sink);
+        return sink.count();
+    };
+
+    BENCHMARK("BatchedShapeGroup - vector<Text>")
+    {
+        NullSink sink;
+        batched_group.draw(sink);
+        return sink.count();
+    };
+}
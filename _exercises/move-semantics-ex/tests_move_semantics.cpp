@@ -34,4 +34,72 @@ TEST_CASE("ShapeGroup")
 
     Text& t = dynamic_cast<Text&>(*sg.shapes[0]);
     REQUIRE(t.text() == "text"s);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Paragraph - storage")
+{
+    using LegacyCode::Paragraph;
+
+    SECTION("short text is stored inline")
+    {
+        Paragraph p{"short"};
+        REQUIRE(p.get_paragraph() == "short"s);
+        REQUIRE(p.heap_size() == 0);
+    }
+
+    SECTION("long text gets a buffer of exact size")
+    {
+        const std::string text(2'000, 'x');
+        Paragraph p{text.c_str()};
+        REQUIRE(p.get_paragraph() == text);
+        REQUIRE(p.heap_size() == text.size() + 1);
+    }
+
+    SECTION("copy")
+    {
+        const std::string text(100, 'x');
+        Paragraph p{text.c_str()};
+        Paragraph copy = p;
+        REQUIRE(copy.get_paragraph() == text);
+        REQUIRE(copy.get_paragraph() != p.get_paragraph());
+
+        Paragraph short_p{"short"};
+        copy = short_p;
+        REQUIRE(copy.get_paragraph() == "short"s);
+        short_p = p;
+        REQUIRE(short_p.get_paragraph() == text);
+    }
+
+    SECTION("set_paragraph grows the buffer")
+    {
+        Paragraph p;
+        REQUIRE(p.get_paragraph() == "Default text!"s);
+
+        const std::string text(50, 'x');
+        p.set_paragraph(text.c_str());
+        REQUIRE(p.get_paragraph() == text);
+
+        p.set_paragraph("abc");
+        REQUIRE(p.get_paragraph() == "abc"s);
+    }
+
+    SECTION("moving inline & heap text")
+    {
+        Paragraph short_p{"short"};
+        Paragraph long_p{std::string(100, 'x').c_str()};
+
+        Paragraph target = std::move(short_p);
+        REQUIRE(target.get_paragraph() == "short"s);
+        REQUIRE(short_p.get_paragraph() == nullptr);
+
+        target = std::move(long_p);
+        REQUIRE(target.get_paragraph() == std::string(100, 'x'));
+        REQUIRE(long_p.get_paragraph() == nullptr);
+
+        long_p = std::move(target);
+        REQUIRE(long_p.get_paragraph() == std::string(100, 'x'));
+
+        target.set_paragraph("reused after move");
+        REQUIRE(target.get_paragraph() == "reused after move"s);
+    }
+}
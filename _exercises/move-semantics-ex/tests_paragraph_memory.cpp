@@ -0,0 +1,63 @@
+#include "paragraph.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <numeric>
+
+namespace
+{
+    std::size_t memory_footprint(const ShapeGroup& group)
+    {
+        return std::accumulate(group.shapes.begin(), group.shapes.end(), std::size_t{},
+            [](std::size_t total, const auto& shape) { return total + static_cast<const Text&>(*shape).memory_footprint(); });
+    }
+
+    ShapeGroup create_scene(int count, const std::string& text)
+    {
+        ShapeGroup group;
+        group.shapes.reserve(count);
+
+        for (int i = 0; i < count; ++i)
+            group.add(std::make_unique<Text>(i, i, text));
+
+        return group;
+    }
+}
+
+TEST_CASE("Paragraph - memory footprint")
+{
+    constexpr int count = 1'000;
+
+    SECTION("short texts are stored inside the shape")
+    {
+        ShapeGroup group = create_scene(count, "label");
+
+        REQUIRE(memory_footprint(group) == count * sizeof(Text));
+    }
+
+    SECTION("long texts get buffers sized to the text")
+    {
+        const std::string text(100, 'x');
+        ShapeGroup group = create_scene(count, text);
+
+        REQUIRE(memory_footprint(group) == count * (sizeof(Text) + text.size() + 1));
+    }
+}
+
+TEST_CASE("Paragraph - memory footprint of a scene", "[.][benchmark]")
+{
+    constexpr int count = 100'000;
+
+    for (const std::string text : {"label", "a label that does not fit in the inline buffer"})
+    {
+        const std::string suffix = " - text: " + std::to_string(text.size());
+
+        std::cout << "ShapeGroup with " << count << " Text shapes" << suffix << ": "
+                  << memory_footprint(create_scene(count, text)) / count << " bytes per shape\n";
+
+        BENCHMARK("build & destroy ShapeGroup" + suffix)
+        {
+            return create_scene(count, text).shapes.size();
+        };
+    }
+}
@@ -0,0 +1,95 @@
+#include "parallel_draw.hpp"
+#include "null_buffer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <sstream>
+
+namespace
+{
+    // tree with groups of different sizes & depths mixed with plain shapes
+    ShapeGroup create_tree(int depth, int shapes_per_group, int& id)
+    {
+        ShapeGroup group;
+
+        for (int i = 0; i < shapes_per_group; ++i)
+        {
+            ++id;
+            group.add(std::make_unique<Text>(id, depth, "text#" + std::to_string(id)));
+
+            if (depth > 0 && i % (shapes_per_group / 3 + 1) == 0)
+                group.add(std::make_unique<ShapeGroup>(create_tree(depth - 1, shapes_per_group, id)));
+        }
+
+        group.add(std::make_unique<ShapeGroup>()); // empty group
+
+        return group;
+    }
+
+    std::string draw_serial(const ShapeGroup& group)
+    {
+        std::ostringstream out;
+        StreamSink sink{out};
+        group.draw(sink);
+        return out.str();
+    }
+}
+
+TEST_CASE("Parallel draw")
+{
+    int id = 0;
+    const ShapeGroup tree = create_tree(3, 50, id);
+    const std::string expected = draw_serial(tree);
+
+    for (unsigned thread_count : {1u, 2u, 4u, 8u})
+    {
+        for (std::size_t grain_size : {1u, 7u, 4096u})
+        {
+            std::ostringstream out;
+            Parallel::draw(tree, out, thread_count, grain_size);
+
+            INFO("threads: " << thread_count << "; grain: " << grain_size);
+            REQUIRE(out.str() == expected);
+        }
+    }
+
+    SECTION("empty group")
+    {
+        std::ostringstream out;
+        Parallel::draw(ShapeGroup{}, out, 4);
+        REQUIRE(out.str().empty());
+    }
+}
+
+TEST_CASE("Parallel draw - 1M shapes", "[.][benchmark]")
+{
+    constexpr int groups = 100;
+    constexpr int shapes_per_group = 10'000;
+
+    ShapeGroup scene;
+    for (int g = 0; g < groups; ++g)
+    {
+        auto group = std::make_unique<ShapeGroup>();
+        for (int i = 0; i < shapes_per_group; ++i)
+            group->add(std::make_unique<Text>(i, g, "label"));
+        scene.add(std::move(group));
+    }
+
+    NullBuffer null_buffer;
+    std::ostream null_stream{&null_buffer};
+
+    BENCHMARK("serial - BatchedSink")
+    {
+        BatchedSink sink{null_stream};
+        scene.draw(sink);
+    };
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+    {
+        BENCHMARK("parallel - threads: " + std::to_string(thread_count))
+        {
+            Parallel::draw(scene, null_stream, thread_count);
+        };
+    }
+}
@@ -0,0 +1,92 @@
+#include "paragraph.hpp"
+#include "null_buffer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <sstream>
+
+namespace
+{
+    ShapeGroup create_scene(int count)
+    {
+        ShapeGroup group;
+        group.shapes.reserve(count);
+
+        for (int i = 0; i < count; ++i)
+            group.add(std::make_unique<Text>(i, -i, "label#" + std::to_string(i)));
+
+        return group;
+    }
+}
+
+TEST_CASE("Render sinks")
+{
+    ShapeGroup scene = create_scene(1'000);
+
+    std::ostringstream expected;
+    StreamSink stream_sink{expected};
+    scene.draw(stream_sink);
+
+    SECTION("BatchedSink writes the same output as StreamSink")
+    {
+        std::ostringstream out;
+        {
+            BatchedSink sink{out};
+            scene.draw(sink);
+        }
+
+        REQUIRE(out.str() == expected.str());
+    }
+
+    SECTION("BatchedSink writes when the threshold is exceeded")
+    {
+        std::ostringstream out;
+        BatchedSink sink{out, 1'024};
+        scene.draw(sink);
+
+        REQUIRE(sink.pending().size() < 1'024);
+        REQUIRE(out.str().size() + sink.pending().size() == expected.str().size());
+
+        sink.flush();
+        REQUIRE(sink.pending().empty());
+        REQUIRE(out.str() == expected.str());
+    }
+
+    SECTION("NullSink only counts")
+    {
+        NullSink sink;
+        scene.draw(sink);
+
+        REQUIRE(sink.count() == 1'000);
+    }
+}
+
+TEST_CASE("Render sinks - draw", "[.][benchmark]")
+{
+    constexpr int count = 1'000'000;
+
+    const ShapeGroup scene = create_scene(count);
+
+    NullBuffer null_buffer;
+    std::ostream null_stream{&null_buffer};
+
+    BENCHMARK("StreamSink")
+    {
+        StreamSink sink{null_stream};
+        scene.draw(sink);
+    };
+
+    BENCHMARK("BatchedSink")
+    {
+        BatchedSink sink{null_stream};
+        scene.draw(sink);
+        sink.flush();
+    };
+
+    BENCHMARK("NullSink")
+    {
+        NullSink sink;
+        scene.draw(sink);
+        return sink.count();
+    };
+}
@@ -0,0 +1,124 @@
+#include "paragraph.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <memory_resource>
+#include <sstream>
+
+namespace
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+        std::pmr::memory_resource* upstream_ = std::pmr::new_delete_resource();
+
+    public:
+        std::size_t allocations{};
+        std::size_t bytes_in_use{};
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            bytes_in_use += bytes;
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            bytes_in_use -= bytes;
+            upstream_->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    const std::string long_text = "text that does not fit in the inline buffer of a paragraph";
+}
+
+TEST_CASE("ShapeGroup with an arena")
+{
+    constexpr int count = 10'000;
+
+    CountingResource upstream;
+
+    {
+        ShapeGroup group{64 * 1024, &upstream};
+        REQUIRE(group.has_arena());
+
+        for (int i = 0; i < count; ++i)
+            group.emplace<Text>(i, i, long_text);
+
+        SECTION("shapes & texts are allocated in large blocks")
+        {
+            REQUIRE(group.shapes.size() == count);
+            REQUIRE(upstream.allocations < 20);
+            REQUIRE(upstream.bytes_in_use >= count * (sizeof(Text) + long_text.size() + 1));
+        }
+
+        SECTION("shapes are drawn as usual")
+        {
+            std::ostringstream out;
+            StreamSink sink{out};
+            group.draw(sink);
+
+            REQUIRE(out.str().find("Rendering text '" + long_text + "' at: [9999, 9999]") != std::string::npos);
+        }
+
+        SECTION("shapes added with make_unique can be mixed with arena shapes")
+        {
+            group.add(std::make_unique<Text>(1, 2, long_text));
+            group.emplace<ShapeGroup>().emplace<Text>(3, 4, "nested");
+
+            REQUIRE(group.shapes.size() == count + 2);
+            REQUIRE(dynamic_cast<Text&>(*group.shapes[count]).text() == long_text);
+        }
+
+        SECTION("group can be moved")
+        {
+            ShapeGroup target;
+            target = std::move(group);
+
+            REQUIRE(target.has_arena());
+            REQUIRE(dynamic_cast<Text&>(*target.shapes.back()).text() == long_text);
+        }
+    }
+
+    REQUIRE(upstream.bytes_in_use == 0);
+}
+
+TEST_CASE("ShapeGroup without an arena - emplace")
+{
+    ShapeGroup group;
+    REQUIRE_FALSE(group.has_arena());
+
+    Text& text = group.emplace<Text>(1, 2, long_text);
+    REQUIRE(&text == group.shapes[0].get());
+    REQUIRE(text.text() == long_text);
+}
+
+TEST_CASE("ShapeGroup - build & teardown", "[.][benchmark]")
+{
+    for (int count : {10'000, 1'000'000})
+    {
+        const std::string suffix = " - shapes: " + std::to_string(count);
+
+        BENCHMARK("make_unique" + suffix)
+        {
+            ShapeGroup group;
+            for (int i = 0; i < count; ++i)
+                group.add(std::make_unique<Text>(i, i, long_text));
+            return group.shapes.size();
+        };
+
+        BENCHMARK("arena" + suffix)
+        {
+            ShapeGroup group{count * (sizeof(Text) + long_text.size() + 1)};
+            for (int i = 0; i < count; ++i)
+                group.emplace<Text>(i, i, long_text);
+            return group.shapes.size();
+        };
+    }
+}
@@ -1,15 +1,77 @@
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// typed event - its text is formatted only if an observer asks for it,
+// into a buffer reused by the subject (no allocation per notification)
+class StateChanged
+{
+    int state_;
+    std::string* text_buffer_;
+    mutable bool formatted_ = false;
+
+public:
+    StateChanged(int state, std::string& text_buffer)
+        : state_{state}
+        , text_buffer_{&text_buffer}
+    {
+    }
+
+    int state() const noexcept
+    {
+        return state_;
+    }
+
+    const std::string& text() const
+    {
+        if (!formatted_)
+        {
+            char digits[std::numeric_limits<int>::digits10 + 2];
+            const auto [end, error] = std::to_chars(std::begin(digits), std::end(digits), state_);
+
+            text_buffer_->assign("Changed state on: ");
+            text_buffer_->append(digits, end);
+            formatted_ = true;
+        }
+
+        return *text_buffer_;
+    }
+};
 
 class Observer
 {
 public:
     virtual void update(const std::string& event_args) = 0;
+
+    // observers that need only the state override it - by default the text of the event is passed to update()
+    virtual void on_state_changed(const StateChanged& event)
+    {
+        update(event.text());
+    }
+
     virtual ~Observer() = default;
 };
 
@@ -88,86 +150,1515 @@ namespace Ver_2
             }
         }
 
+        // registered observers that are still alive
+        std::size_t live_observers_count() const
+        {
+            return std::ranges::count_if(observers_, [](const std::weak_ptr<Observer>& observer) { return !observer.expired(); });
+        }
+
+        // destroyed observers not yet removed by notify()
+        std::size_t expired_observers_count() const
+        {
+            return observers_.size() - live_observers_count();
+        }
+
     protected:
+        // expired observers are removed during the pass - they do not slow down next notifications
         void notify(const std::string& event_args)
         {
-            for (std::weak_ptr<Observer> observer : observers_)
+            for (auto it = observers_.begin(); it != observers_.end();)
             {
-                if (std::shared_ptr<Observer> living_observer = observer.lock(); living_observer)
+                if (std::shared_ptr<Observer> living_observer = it->lock(); living_observer)
+                {
                     living_observer->update(event_args);
+                    ++it;
+                }
+                else
+                {
+                    it = observers_.erase(it);
+                }
             }
         }
     };
 } // namespace Ver_1
 
-class ConcreteObserver1 : public Observer
+// handle of an item in a SlotMap - a generation of the slot detects stale handles
+struct SlotHandle
 {
-public:
-    virtual void update(const std::string& event)
-    {
-        std::cout << "ConcreteObserver1: " << event << std::endl;
-    }
+    std::uint32_t index;
+    std::uint32_t generation;
+
+    friend bool operator==(const SlotHandle&, const SlotHandle&) = default;
 };
 
-class ConcreteObserver2 : public Observer
+////////////////////////////////////////////////////////////////
+// Slot map - items are stored contiguously (iteration is a linear scan);
+// insert & erase are O(1) - erase moves the last item into the gap
+template <typename T>
+class SlotMap
 {
+    static constexpr std::uint32_t end_of_free_list = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot
+    {
+        std::uint32_t index; // index of an item - or the next free slot
+        std::uint32_t generation;
+    };
+
+    std::vector<T> items_;
+    std::vector<std::uint32_t> item_slots_; // slot of each item
+    std::vector<Slot> slots_;
+    std::uint32_t free_head_ = end_of_free_list;
+
 public:
-    virtual void update(const std::string& event)
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    void reserve(std::size_t capacity)
     {
-        std::cout << "ConcreteObserver2: " << event << std::endl;
+        items_.reserve(capacity);
+        item_slots_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    SlotHandle insert(T item)
+    {
+        std::uint32_t slot_index = free_head_;
+
+        if (slot_index != end_of_free_list)
+        {
+            free_head_ = slots_[slot_index].index;
+        }
+        else
+        {
+            slot_index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot{0, 0});
+        }
+
+        Slot& slot = slots_[slot_index];
+        slot.index = static_cast<std::uint32_t>(items_.size());
+
+        items_.push_back(std::move(item));
+        item_slots_.push_back(slot_index);
+
+        return SlotHandle{slot_index, slot.generation};
+    }
+
+    // returns false for a stale handle
+    bool erase(SlotHandle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        Slot& slot = slots_[handle.index];
+        const std::uint32_t index = slot.index;
+
+        // the last item fills the gap
+        items_[index] = std::move(items_.back());
+        item_slots_[index] = item_slots_.back();
+        slots_[item_slots_[index]].index = index;
+        items_.pop_back();
+        item_slots_.pop_back();
+
+        ++slot.generation;
+        slot.index = std::exchange(free_head_, handle.index);
+
+        return true;
+    }
+
+    bool contains(SlotHandle handle) const
+    {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation;
+    }
+
+    T* find(SlotHandle handle)
+    {
+        return contains(handle) ? &items_[slots_[handle.index].index] : nullptr;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return items_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return items_.empty();
+    }
+
+    iterator begin() noexcept
+    {
+        return items_.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return items_.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return items_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items_.end();
     }
 };
 
-TEST_CASE("using observer pattern - ver 1")
+namespace Ver_3
 {
-    using namespace std;
+    using ObserverHandle = SlotHandle;
 
-    Ver_1::Subject s;
+    // subject with a contiguous registry - notify() is a linear scan instead of a walk through a tree
+    // (observers must not be registered or unregistered during notify())
+    class Subject
+    {
+        int state_;
+        SlotMap<Observer*> observers_;
+        std::string event_text_; // reused by events
+        bool notifying_ = false;
 
-    auto deregister_observer = [&s](Observer* o) {
-        s.unregister_observer(o);
-        delete o;
+    public:
+        Subject()
+            : state_(0)
+        {
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            observers_.reserve(capacity);
+        }
+
+        ObserverHandle register_observer(Observer* observer)
+        {
+            return observers_.insert(observer);
+        }
+
+        // returns false if the observer was already unregistered
+        bool unregister_observer(ObserverHandle handle)
+        {
+            return observers_.erase(handle);
+        }
+
+        bool is_registered(ObserverHandle handle) const
+        {
+            return observers_.contains(handle);
+        }
+
+        std::size_t observers_count() const noexcept
+        {
+            return observers_.size();
+        }
+
+        void set_state(int new_state)
+        {
+            if (state_ != new_state)
+            {
+                state_ = new_state;
+
+                if (notifying_)
+                {
+                    // called by an observer - event_text_ may hold the text of the outer event
+                    std::string nested_event_text;
+                    notify(StateChanged{state_, nested_event_text});
+                    return;
+                }
+
+                notifying_ = true;
+                try
+                {
+                    notify(StateChanged{state_, event_text_});
+                }
+                catch (...)
+                {
+                    notifying_ = false;
+                    throw;
+                }
+                notifying_ = false;
+            }
+        }
+
+    protected:
+        void notify(const StateChanged& event)
+        {
+            constexpr std::size_t prefetch_distance = 8;
+
+            const auto observers = observers_.begin();
+            const std::size_t count = observers_.size();
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+#if defined(__GNUC__)
+                if (i + prefetch_distance < count)
+                    __builtin_prefetch(observers[i + prefetch_distance]); // an object (vptr) of the next observers
+#endif
+                observers[i]->on_state_changed(event);
+            }
+        }
     };
-    using TDeregisterObserver = decltype(deregister_observer);
+} // namespace Ver_3
 
-    std::unique_ptr<Observer, TDeregisterObserver> o1{new ConcreteObserver1(), deregister_observer};
-    s.register_observer(o1.get());
+////////////////////////////////////////////////////////////////
+// Fixed number of workers executing submitted tasks in FIFO order
+class ThreadPool
+{
+    std::mutex mtx_;
+    std::condition_variable work_available_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_ = false;
+    std::vector<std::jthread> workers_;
 
+    void work()
     {
-        // ConcreteObserver2* o2 = new ConcreteObserver2;
-        std::shared_ptr<Observer> o2{new ConcreteObserver2(), deregister_observer};
-        s.register_observer(o2.get());
+        while (true)
+        {
+            std::function<void()> task;
 
-        s.set_state(1);
+            {
+                std::unique_lock lk{mtx_};
+                work_available_.wait(lk, [this] { return stop_ || !tasks_.empty(); });
 
-        o2.reset();
+                if (tasks_.empty())
+                    return; // stopped & all tasks done
 
-        cout << "End of scope." << endl;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            task();
+        }
     }
 
-    s.set_state(2);
-}
+public:
+    explicit ThreadPool(unsigned thread_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        for (unsigned i = 0; i < thread_count; ++i)
+            workers_.emplace_back([this] { work(); });
+    }
 
-TEST_CASE("using observer pattern - ver 2")
-{
-    using namespace std;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
 
-    Ver_2::Subject s;
+    // pending tasks are executed before workers stop
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lk{mtx_};
+            stop_ = true;
+        }
+        work_available_.notify_all();
+    }
 
-    std::shared_ptr<Observer> o1 = std::make_shared<ConcreteObserver1>();
-    s.register_observer(o1);
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard lk{mtx_};
+            tasks_.push_back(std::move(task));
+        }
+        work_available_.notify_one();
+    }
+};
+
+namespace Ver_4
+{
+    using ObserverHandle = SlotHandle;
 
+    enum class Delivery
     {
-        std::shared_ptr<Observer> o2 = std::make_shared<ConcreteObserver2>();
+        every_change, // every observer receives all events in order
+        latest_only   // pending events of an observer are coalesced - a slow observer gets only the latest one
+    };
 
-        s.register_observer(o2);
+    ////////////////////////////////////////////////////////////////
+    // subject that delivers events on a thread pool - set_state() only enqueues states;
+    // every observer has a mailbox drained by one task at a time, so update() of an observer
+    // is never called concurrently & all pending events are delivered in one batch
+    //
+    // register, unregister & set_state are called by the owner of the subject (not from update())
+    class Subject
+    {
+        struct Mailbox
+        {
+            Observer* observer;
+            std::mutex mtx;
+            std::condition_variable idle;
+            std::vector<int> states;
+            std::string event_text; // reused by events delivered to the observer
+            bool scheduled = false; // a delivery task is queued or running
+            bool closed = false;
 
-        s.set_state(1);
+            explicit Mailbox(Observer* observer)
+                : observer{observer}
+            {
+            }
+        };
 
-        o2.reset();
+        int state_;
+        ThreadPool& pool_;
+        Delivery delivery_;
+        SlotMap<std::shared_ptr<Mailbox>> mailboxes_;
 
-        cout << "End of scope." << endl;
-    }
+        std::mutex deliveries_mtx_;
+        std::condition_variable deliveries_done_;
+        std::size_t scheduled_deliveries_ = 0;
 
-    s.set_state(2);
+        // an exception thrown by update() is reported & dropped - the next events are still delivered
+        // and the bookkeeping below always completes (flush & unregister_observer would wait forever)
+        static void deliver_event(Observer& observer, int state, std::string& event_text) noexcept
+        {
+            try
+            {
+                observer.on_state_changed(StateChanged{state, event_text});
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Observer failed to handle state " << state << ": " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                std::cerr << "Observer failed to handle state " << state << std::endl;
+            }
+        }
+
+        void deliver(Mailbox& mailbox)
+        {
+            std::vector<int> batch;
+
+            std::unique_lock lk{mailbox.mtx};
+            while (!mailbox.states.empty() && !mailbox.closed)
+            {
+                batch.swap(mailbox.states);
+                lk.unlock();
+
+                for (int state : batch)
+                    deliver_event(*mailbox.observer, state, mailbox.event_text);
+                batch.clear();
+
+                lk.lock();
+            }
+            mailbox.states.clear();
+            mailbox.scheduled = false;
+            mailbox.idle.notify_all();
+            lk.unlock();
+
+            std::lock_guard deliveries_lk{deliveries_mtx_};
+            --scheduled_deliveries_;
+            deliveries_done_.notify_all(); // subject may be destroyed as soon as the mutex is released
+        }
+
+        void post(const std::shared_ptr<Mailbox>& mailbox, int state)
+        {
+            {
+                std::lock_guard lk{mailbox->mtx};
+
+                if (delivery_ == Delivery::latest_only)
+                    mailbox->states.clear();
+                mailbox->states.push_back(state);
+
+                if (std::exchange(mailbox->scheduled, true))
+                    return; // a running delivery takes the event
+            }
+
+            {
+                std::lock_guard deliveries_lk{deliveries_mtx_};
+                ++scheduled_deliveries_;
+            }
+
+            pool_.submit([this, mailbox] { deliver(*mailbox); });
+        }
+
+    public:
+        explicit Subject(ThreadPool& pool, Delivery delivery = Delivery::every_change)
+            : state_(0)
+            , pool_{pool}
+            , delivery_{delivery}
+        {
+        }
+
+        Subject(const Subject&) = delete;
+        Subject& operator=(const Subject&) = delete;
+
+        // pending events are delivered
+        ~Subject()
+        {
+            flush();
+        }
+
+        ObserverHandle register_observer(Observer* observer)
+        {
+            return mailboxes_.insert(std::make_shared<Mailbox>(observer));
+        }
+
+        // pending events of the observer are discarded; waits for a running update() -
+        // update() is not called after return
+        bool unregister_observer(ObserverHandle handle)
+        {
+            std::shared_ptr<Mailbox>* mailbox = mailboxes_.find(handle);
+            if (!mailbox)
+                return false;
+
+            {
+                std::unique_lock lk{(*mailbox)->mtx};
+                (*mailbox)->closed = true;
+                (*mailbox)->idle.wait(lk, [&] { return !(*mailbox)->scheduled; });
+            }
+
+            return mailboxes_.erase(handle);
+        }
+
+        void set_state(int new_state)
+        {
+            if (state_ != new_state)
+            {
+                state_ = new_state;
+                notify(state_);
+            }
+        }
+
+        // waits until all events posted so far are delivered
+        void flush()
+        {
+            std::unique_lock lk{deliveries_mtx_};
+            deliveries_done_.wait(lk, [this] { return scheduled_deliveries_ == 0; });
+        }
+
+    protected:
+        // events are created (& formatted if needed) when delivered
+        void notify(int state)
+        {
+            for (const std::shared_ptr<Mailbox>& mailbox : mailboxes_)
+                post(mailbox, state);
+        }
+    };
+} // namespace Ver_4
+
+namespace Ver_5
+{
+    ////////////////////////////////////////////////////////////////
+    // thread-safe subject - notify() iterates an immutable snapshot of observers
+    // loaded from an atomic shared_ptr; register & unregister publish a modified copy (copy-on-write),
+    // so they never block notifications & notifications never wait for them
+    //
+    // a snapshot owns its observers - a notification that started before unregister_observer()
+    // can still call update(), but never on a destroyed observer
+    class Subject
+    {
+        using Observers = std::vector<std::shared_ptr<Observer>>;
+
+        std::atomic<int> state_;
+        std::atomic<std::shared_ptr<const Observers>> observers_;
+
+        // applies modify to a copy of the current snapshot & publishes it unless another writer was first
+        template <typename TModify>
+        bool update_observers(TModify modify)
+        {
+            std::shared_ptr<const Observers> current = observers_.load(std::memory_order_acquire);
+
+            while (true)
+            {
+                auto modified = std::make_shared<Observers>(*current);
+                if (!modify(*modified))
+                    return false;
+
+                if (observers_.compare_exchange_weak(current, std::move(modified), std::memory_order_acq_rel, std::memory_order_acquire))
+                    return true;
+            }
+        }
+
+    public:
+        Subject()
+            : state_(0)
+            , observers_(std::make_shared<const Observers>())
+        {
+        }
+
+        void register_observer(std::shared_ptr<Observer> observer)
+        {
+            update_observers([&observer](Observers& observers) {
+                observers.push_back(observer);
+                return true;
+            });
+        }
+
+        // returns false if the observer is not registered
+        bool unregister_observer(const std::shared_ptr<Observer>& observer)
+        {
+            return update_observers([&observer](Observers& observers) {
+                auto it = std::find(observers.begin(), observers.end(), observer);
+                if (it == observers.end())
+                    return false;
+
+                *it = std::move(observers.back());
+                observers.pop_back();
+                return true;
+            });
+        }
+
+        std::size_t observers_count() const
+        {
+            return observers_.load(std::memory_order_acquire)->size();
+        }
+
+        void set_state(int new_state)
+        {
+            if (state_.exchange(new_state, std::memory_order_relaxed) != new_state)
+                notify(new_state);
+        }
+
+    protected:
+        void notify(int state)
+        {
+            thread_local std::string event_text; // reused by events of the notifying thread
+            thread_local bool notifying = false;
+
+            const std::shared_ptr<const Observers> snapshot = observers_.load(std::memory_order_acquire);
+
+            if (notifying)
+            {
+                // called by an observer - event_text may hold the text of the outer event
+                std::string nested_event_text;
+                const StateChanged event{state, nested_event_text};
+                for (const std::shared_ptr<Observer>& observer : *snapshot)
+                    observer->on_state_changed(event);
+                return;
+            }
+
+            notifying = true;
+            try
+            {
+                const StateChanged event{state, event_text};
+                for (const std::shared_ptr<Observer>& observer : *snapshot)
+                    observer->on_state_changed(event);
+            }
+            catch (...)
+            {
+                notifying = false;
+                throw;
+            }
+            notifying = false;
+        }
+    };
+} // namespace Ver_5
+
+class ConcreteObserver1 : public Observer
+{
+public:
+    virtual void update(const std::string& event)
+    {
+        std::cout << "ConcreteObserver1: " << event << std::endl;
+    }
+};
+
+class ConcreteObserver2 : public Observer
+{
+public:
+    virtual void update(const std::string& event)
+    {
+        std::cout << "ConcreteObserver2: " << event << std::endl;
+    }
+};
+
+TEST_CASE("using observer pattern - ver 1")
+{
+    using namespace std;
+
+    Ver_1::Subject s;
+
+    auto deregister_observer = [&s](Observer* o) {
+        s.unregister_observer(o);
+        delete o;
+    };
+    using TDeregisterObserver = decltype(deregister_observer);
+
+    std::unique_ptr<Observer, TDeregisterObserver> o1{new ConcreteObserver1(), deregister_observer};
+    s.register_observer(o1.get());
+
+    {
+        // ConcreteObserver2* o2 = new ConcreteObserver2;
+        std::shared_ptr<Observer> o2{new ConcreteObserver2(), deregister_observer};
+        s.register_observer(o2.get());
+
+        s.set_state(1);
+
+        o2.reset();
+
+        cout << "End of scope." << endl;
+    }
+
+    s.set_state(2);
+}
+
+TEST_CASE("using observer pattern - ver 2")
+{
+    using namespace std;
+
+    Ver_2::Subject s;
+
+    std::shared_ptr<Observer> o1 = std::make_shared<ConcreteObserver1>();
+    s.register_observer(o1);
+
+    {
+        std::shared_ptr<Observer> o2 = std::make_shared<ConcreteObserver2>();
+
+        s.register_observer(o2);
+
+        s.set_state(1);
+
+        o2.reset();
+
+        cout << "End of scope." << endl;
+    }
+
+    s.set_state(2);
+}
+
+namespace
+{
+    class CountingObserver : public Observer
+    {
+    public:
+        int updates_count = 0;
+        std::string last_event;
+
+        void update(const std::string& event) override
+        {
+            ++updates_count;
+            last_event = event;
+        }
+    };
+
+    class SilentObserver : public Observer
+    {
+    public:
+        std::size_t events_length = 0;
+
+        void update(const std::string& event) override
+        {
+            events_length += event.size();
+        }
+    };
+} // namespace
+
+TEST_CASE("using observer pattern - ver 3")
+{
+    Ver_3::Subject s;
+
+    CountingObserver o1, o2, o3;
+    const Ver_3::ObserverHandle h1 = s.register_observer(&o1);
+    const Ver_3::ObserverHandle h2 = s.register_observer(&o2);
+    const Ver_3::ObserverHandle h3 = s.register_observer(&o3);
+    REQUIRE(s.observers_count() == 3);
+
+    SECTION("all observers are notified")
+    {
+        s.set_state(1);
+
+        REQUIRE(o1.updates_count == 1);
+        REQUIRE(o2.updates_count == 1);
+        REQUIRE(o3.updates_count == 1);
+        REQUIRE(o3.last_event == "Changed state on: 1");
+    }
+
+    SECTION("unregistered observer is not notified")
+    {
+        REQUIRE(s.unregister_observer(h1));
+        REQUIRE_FALSE(s.is_registered(h1));
+        REQUIRE(s.is_registered(h3)); // moved into the gap
+
+        s.set_state(1);
+
+        REQUIRE(o1.updates_count == 0);
+        REQUIRE(o2.updates_count == 1);
+        REQUIRE(o3.updates_count == 1);
+
+        REQUIRE(s.unregister_observer(h3));
+        REQUIRE(s.unregister_observer(h2));
+        REQUIRE(s.observers_count() == 0);
+    }
+
+    SECTION("stale handle")
+    {
+        REQUIRE(s.unregister_observer(h2));
+        REQUIRE_FALSE(s.unregister_observer(h2));
+
+        CountingObserver o4;
+        const Ver_3::ObserverHandle h4 = s.register_observer(&o4); // reuses the slot of h2
+        REQUIRE(h4.index == h2.index);
+        REQUIRE_FALSE(s.unregister_observer(h2));
+        REQUIRE(s.is_registered(h4));
+
+        s.set_state(1);
+        REQUIRE(o2.updates_count == 0);
+        REQUIRE(o4.updates_count == 1);
+    }
+}
+
+TEST_CASE("using observer pattern - ver 2 - expired observers are pruned")
+{
+    Ver_2::Subject s;
+
+    auto o1 = std::make_shared<CountingObserver>();
+    auto o2 = std::make_shared<CountingObserver>();
+    auto o3 = std::make_shared<CountingObserver>();
+    s.register_observer(o1);
+    s.register_observer(o2);
+    s.register_observer(o3);
+
+    o1.reset();
+    o3.reset();
+
+    REQUIRE(s.live_observers_count() == 1);
+    REQUIRE(s.expired_observers_count() == 2);
+
+    s.set_state(1);
+
+    REQUIRE(o2->updates_count == 1);
+    REQUIRE(s.live_observers_count() == 1);
+    REQUIRE(s.expired_observers_count() == 0);
+}
+
+namespace
+{
+    class RecordingObserver : public Observer
+    {
+    public:
+        std::vector<std::string> events;
+
+        void update(const std::string& event) override
+        {
+            events.push_back(event);
+        }
+    };
+
+    // first update() blocks until the gate is opened
+    class GatedObserver : public RecordingObserver
+    {
+    public:
+        std::atomic<bool> entered{false};
+        std::atomic<bool> open{false};
+
+        void update(const std::string& event) override
+        {
+            entered = true;
+            entered.notify_all();
+            open.wait(false);
+
+            RecordingObserver::update(event);
+        }
+    };
+
+    // events of odd states are rejected with an exception
+    class ThrowingObserver : public RecordingObserver
+    {
+    public:
+        void on_state_changed(const StateChanged& event) override
+        {
+            if (event.state() % 2 != 0)
+                throw std::runtime_error("odd state");
+
+            RecordingObserver::on_state_changed(event);
+        }
+    };
+
+    std::vector<std::string> events_for_states(int first, int last)
+    {
+        std::vector<std::string> events;
+        for (int state = first; state <= last; ++state)
+            events.push_back("Changed state on: " + std::to_string(state));
+        return events;
+    }
+} // namespace
+
+TEST_CASE("using observer pattern - ver 4 - async dispatch")
+{
+    ThreadPool pool{2};
+
+    SECTION("every change is delivered in order")
+    {
+        RecordingObserver o1, o2, o3;
+
+        Ver_4::Subject s{pool};
+        s.register_observer(&o1);
+        s.register_observer(&o2);
+        s.register_observer(&o3);
+
+        for (int state = 1; state <= 100; ++state)
+            s.set_state(state);
+        s.flush();
+
+        REQUIRE(o1.events == events_for_states(1, 100));
+        REQUIRE(o2.events == events_for_states(1, 100));
+        REQUIRE(o3.events == events_for_states(1, 100));
+    }
+
+    SECTION("latest only - pending events of a slow observer are coalesced")
+    {
+        GatedObserver slow;
+        RecordingObserver fast;
+
+        Ver_4::Subject s{pool, Ver_4::Delivery::latest_only};
+        s.register_observer(&slow);
+
+        s.set_state(1);
+        slow.entered.wait(false); // event 1 is being delivered
+
+        s.register_observer(&fast);
+        for (int state = 2; state <= 100; ++state)
+            s.set_state(state);
+
+        slow.open = true;
+        slow.open.notify_all();
+        s.flush();
+
+        REQUIRE(slow.events == std::vector<std::string>{"Changed state on: 1", "Changed state on: 100"});
+        REQUIRE(fast.events.back() == "Changed state on: 100");
+    }
+
+    SECTION("unregistered observer is not notified")
+    {
+        GatedObserver o1;
+        RecordingObserver o2;
+
+        Ver_4::Subject s{pool};
+        const Ver_4::ObserverHandle h1 = s.register_observer(&o1);
+        s.register_observer(&o2);
+
+        s.set_state(1);
+        o1.entered.wait(false);
+        s.set_state(2); // pending for o1
+
+        std::jthread opener{[&o1] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            o1.open = true;
+            o1.open.notify_all();
+        }};
+
+        REQUIRE(s.unregister_observer(h1)); // waits for the running update()
+        REQUIRE(o1.events == events_for_states(1, 1));
+
+        s.set_state(3);
+        s.flush();
+
+        REQUIRE(o1.events == events_for_states(1, 1));
+        REQUIRE(o2.events == events_for_states(1, 3));
+    }
+
+    SECTION("pending events are delivered by destructor")
+    {
+        RecordingObserver o;
+
+        {
+            Ver_4::Subject s{pool};
+            s.register_observer(&o);
+            for (int state = 1; state <= 10; ++state)
+                s.set_state(state);
+        }
+
+        REQUIRE(o.events == events_for_states(1, 10));
+    }
+
+    SECTION("exception thrown by an observer does not stop delivery")
+    {
+        ThrowingObserver throwing;
+        RecordingObserver o;
+
+        Ver_4::Subject s{pool};
+        const Ver_4::ObserverHandle h = s.register_observer(&throwing);
+        s.register_observer(&o);
+
+        for (int state = 1; state <= 4; ++state)
+            s.set_state(state);
+        s.flush();
+
+        REQUIRE(throwing.events == std::vector<std::string>{"Changed state on: 2", "Changed state on: 4"});
+        REQUIRE(o.events == events_for_states(1, 4));
+        REQUIRE(s.unregister_observer(h));
+    }
+}
+
+TEST_CASE("SlotMap")
+{
+    SlotMap<int> slots;
+
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(slots.insert(i));
+
+    for (int i = 0; i < 100; i += 2)
+        REQUIRE(slots.erase(handles[i]));
+
+    REQUIRE(slots.size() == 50);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 2 == 0)
+            REQUIRE(slots.find(handles[i]) == nullptr);
+        else
+            REQUIRE(*slots.find(handles[i]) == i);
+    }
+
+    int sum = 0;
+    for (int item : slots)
+        sum += item;
+    REQUIRE(sum == 2500);
+}
+
+TEST_CASE("observer registry", "[.][benchmark]")
+{
+    for (std::size_t observers_count : {10u, 100u, 1'000u, 10'000u, 100'000u})
+    {
+        const std::string suffix = " - observers: " + std::to_string(observers_count);
+
+        // observers allocated one by one - like in a real application
+        std::vector<std::unique_ptr<SilentObserver>> observers;
+        for (std::size_t i = 0; i < observers_count; ++i)
+            observers.push_back(std::make_unique<SilentObserver>());
+
+        Ver_1::Subject set_subject;
+        Ver_3::Subject slot_map_subject;
+        std::vector<Ver_3::ObserverHandle> handles;
+
+        for (const auto& observer : observers)
+        {
+            set_subject.register_observer(observer.get());
+            handles.push_back(slot_map_subject.register_observer(observer.get()));
+        }
+
+        int state = 0;
+
+        BENCHMARK("notify - std::set" + suffix)
+        {
+            set_subject.set_state(++state);
+        };
+
+        BENCHMARK("notify - SlotMap" + suffix)
+        {
+            slot_map_subject.set_state(++state);
+        };
+
+        BENCHMARK("unregister & register - std::set" + suffix)
+        {
+            for (std::size_t i = 0; i < observers_count; i += 10)
+            {
+                set_subject.unregister_observer(observers[i].get());
+                set_subject.register_observer(observers[i].get());
+            }
+        };
+
+        BENCHMARK("unregister & register - SlotMap" + suffix)
+        {
+            for (std::size_t i = 0; i < observers_count; i += 10)
+            {
+                slot_map_subject.unregister_observer(handles[i]);
+                handles[i] = slot_map_subject.register_observer(observers[i].get());
+            }
+        };
+    }
+}
+
+namespace
+{
+    // notify() of Ver_2::Subject before pruning - expired observers stay registered
+    class NonPruningSubject
+    {
+        int state_ = 0;
+        std::set<std::weak_ptr<Observer>, std::owner_less<std::weak_ptr<Observer>>> observers_;
+
+    public:
+        void register_observer(std::weak_ptr<Observer> observer)
+        {
+            observers_.insert(observer);
+        }
+
+        void set_state(int new_state)
+        {
+            state_ = new_state;
+
+            const std::string event_args = "Changed state on: " + std::to_string(state_);
+            for (std::weak_ptr<Observer> observer : observers_)
+            {
+                if (std::shared_ptr<Observer> living_observer = observer.lock(); living_observer)
+                    living_observer->update(event_args);
+            }
+        }
+    };
+} // namespace
+
+TEST_CASE("expired observers - churn", "[.][benchmark]")
+{
+    constexpr int live_observers_count = 100;
+    constexpr int churn_per_notification = 100; // observers registered & destroyed between notifications
+
+    const auto run = [](auto& subject, int notifications) {
+        std::vector<std::shared_ptr<Observer>> live_observers;
+        for (int i = 0; i < live_observers_count; ++i)
+        {
+            live_observers.push_back(std::make_shared<SilentObserver>());
+            subject.register_observer(live_observers.back());
+        }
+
+        for (int n = 0; n < notifications; ++n)
+        {
+            for (int i = 0; i < churn_per_notification; ++i)
+                subject.register_observer(std::make_shared<SilentObserver>()); // expires at once
+
+            subject.set_state(n + 1);
+        }
+    };
+
+    for (int notifications : {10, 100, 1'000})
+    {
+        const std::string suffix = " - notifications: " + std::to_string(notifications);
+
+        BENCHMARK("no pruning" + suffix)
+        {
+            NonPruningSubject subject;
+            run(subject, notifications);
+        };
+
+        BENCHMARK("pruning in notify()" + suffix)
+        {
+            Ver_2::Subject subject;
+            run(subject, notifications);
+        };
+    }
+}
+
+namespace
+{
+    // simulates processing of an event
+    class WorkingObserver : public Observer
+    {
+    public:
+        std::size_t checksum = 0;
+
+        void update(const std::string& event) override
+        {
+            for (int i = 0; i < 100; ++i)
+                checksum += std::hash<std::string>{}(event) >> (i % 8);
+        }
+    };
+} // namespace
+
+TEST_CASE("async dispatch - sync vs async", "[.][benchmark]")
+{
+    constexpr int changes_count = 100;
+
+    ThreadPool pool;
+
+    for (std::size_t observers_count : {10u, 100u, 1'000u})
+    {
+        const std::string suffix = " - observers: " + std::to_string(observers_count);
+
+        std::vector<WorkingObserver> observers(observers_count);
+
+        Ver_3::Subject sync_subject;
+        Ver_4::Subject async_subject{pool};
+        Ver_4::Subject coalescing_subject{pool, Ver_4::Delivery::latest_only};
+
+        for (WorkingObserver& observer : observers)
+        {
+            sync_subject.register_observer(&observer);
+            async_subject.register_observer(&observer);
+            coalescing_subject.register_observer(&observer);
+        }
+
+        int state = 0;
+
+        // latency - time until set_state() returns
+        BENCHMARK("latency - sync" + suffix)
+        {
+            sync_subject.set_state(++state);
+        };
+
+        BENCHMARK_ADVANCED("latency - async" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure([&] { async_subject.set_state(++state); });
+            async_subject.flush();
+        };
+
+        // throughput - a burst of changes until all of them are delivered
+        BENCHMARK("throughput - sync" + suffix)
+        {
+            for (int i = 0; i < changes_count; ++i)
+                sync_subject.set_state(++state);
+        };
+
+        BENCHMARK("throughput - async" + suffix)
+        {
+            for (int i = 0; i < changes_count; ++i)
+                async_subject.set_state(++state);
+            async_subject.flush();
+        };
+
+        BENCHMARK("throughput - async latest only" + suffix)
+        {
+            for (int i = 0; i < changes_count; ++i)
+                coalescing_subject.set_state(++state);
+            coalescing_subject.flush();
+        };
+    }
+}
+
+namespace
+{
+    // uses only the state - the text of an event is never formatted
+    class StateObserver : public Observer
+    {
+    public:
+        long long states_sum = 0;
+
+        void update(const std::string&) override
+        {
+        }
+
+        void on_state_changed(const StateChanged& event) override
+        {
+            states_sum += event.state();
+        }
+    };
+
+    // reads the text of an event before & after changing the state of the subject from inside the notification
+    template <typename TSubject>
+    class ReentrantObserver : public Observer
+    {
+        TSubject& subject_;
+
+    public:
+        std::vector<std::string> texts;
+
+        explicit ReentrantObserver(TSubject& subject)
+            : subject_{subject}
+        {
+        }
+
+        void update(const std::string&) override
+        {
+        }
+
+        void on_state_changed(const StateChanged& event) override
+        {
+            texts.push_back(event.text());
+            if (event.state() == 1)
+                subject_.set_state(2);
+            texts.push_back(event.text());
+        }
+    };
+} // namespace
+
+TEST_CASE("typed events")
+{
+    SECTION("text is formatted on request")
+    {
+        std::string buffer;
+        const StateChanged event{-42, buffer};
+
+        REQUIRE(event.state() == -42);
+        REQUIRE(buffer.empty());
+
+        REQUIRE(event.text() == "Changed state on: -42");
+        REQUIRE(&event.text() == &buffer);
+    }
+
+    SECTION("state changed by an observer - text of the outer event is kept")
+    {
+        Ver_3::Subject s;
+        ReentrantObserver<Ver_3::Subject> o{s};
+        s.register_observer(&o);
+
+        s.set_state(1);
+
+        REQUIRE(o.texts == std::vector<std::string>{"Changed state on: 1", "Changed state on: 2", "Changed state on: 2", "Changed state on: 1"});
+    }
+
+    SECTION("state changed by an observer of the thread-safe subject - text of the outer event is kept")
+    {
+        Ver_5::Subject s;
+        auto o = std::make_shared<ReentrantObserver<Ver_5::Subject>>(s);
+        s.register_observer(o);
+
+        s.set_state(1);
+
+        REQUIRE(o->texts == std::vector<std::string>{"Changed state on: 1", "Changed state on: 2", "Changed state on: 2", "Changed state on: 1"});
+    }
+
+    SECTION("no allocations per notification")
+    {
+        std::vector<StateObserver> state_observers(100);
+        std::vector<SilentObserver> text_observers(100);
+
+        Ver_3::Subject s;
+        for (auto& observer : state_observers)
+            s.register_observer(&observer);
+
+        SECTION("observers use the state")
+        {
+            const auto allocations_before = Helpers::AllocationCounter::allocations;
+            for (int state = 1; state <= 100; ++state)
+                s.set_state(state);
+            REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+
+            REQUIRE(state_observers.front().states_sum == 5050);
+        }
+
+        SECTION("observers read the text - the buffer is reused")
+        {
+            for (auto& observer : text_observers)
+                s.register_observer(&observer);
+
+            s.set_state(1'000'000'000); // the longest text allocates the buffer
+
+            const auto allocations_before = Helpers::AllocationCounter::allocations;
+            for (int state = 1; state <= 100; ++state)
+                s.set_state(state);
+            REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+
+            REQUIRE(state_observers.front().states_sum == 1'000'000'000 + 5050);
+            REQUIRE(text_observers.front().events_length == 28 + 9 * 19 + 90 * 20 + 21);
+        }
+    }
+}
+
+TEST_CASE("typed events - string vs lazy text", "[.][benchmark]")
+{
+    for (std::size_t observers_count : {10u, 100u, 1'000u})
+    {
+        const std::string suffix = " - observers: " + std::to_string(observers_count);
+
+        std::vector<StateObserver> state_observers(observers_count);
+        std::vector<SilentObserver> text_observers(observers_count);
+
+        Ver_1::Subject string_subject;
+        Ver_3::Subject state_subject;
+        Ver_3::Subject text_subject;
+
+        for (std::size_t i = 0; i < observers_count; ++i)
+        {
+            string_subject.register_observer(&state_observers[i]);
+            state_subject.register_observer(&state_observers[i]);
+            text_subject.register_observer(&text_observers[i]);
+        }
+
+        int state = 0;
+
+        BENCHMARK("std::string per notification" + suffix)
+        {
+            string_subject.set_state(++state);
+        };
+
+        BENCHMARK("typed event - state only" + suffix)
+        {
+            state_subject.set_state(++state);
+        };
+
+        BENCHMARK("typed event - lazy text" + suffix)
+        {
+            text_subject.set_state(++state);
+        };
+    }
+}
+
+namespace
+{
+    class AtomicCountingObserver : public Observer
+    {
+    public:
+        std::atomic<int> updates_count{0};
+
+        void update(const std::string&) override
+        {
+        }
+
+        void on_state_changed(const StateChanged&) override
+        {
+            updates_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+} // namespace
+
+TEST_CASE("using observer pattern - ver 5 - thread-safe subject")
+{
+    Ver_5::Subject s;
+
+    SECTION("register & unregister")
+    {
+        auto o1 = std::make_shared<AtomicCountingObserver>();
+        auto o2 = std::make_shared<AtomicCountingObserver>();
+
+        s.register_observer(o1);
+        s.register_observer(o2);
+        s.set_state(1);
+
+        REQUIRE(s.unregister_observer(o1));
+        REQUIRE_FALSE(s.unregister_observer(o1));
+        s.set_state(2);
+
+        REQUIRE(o1->updates_count == 1);
+        REQUIRE(o2->updates_count == 2);
+        REQUIRE(s.observers_count() == 1);
+    }
+
+    SECTION("notifications while observers are registered & unregistered")
+    {
+        constexpr int notifiers_count = 2;
+        constexpr int notifications_per_thread = 2'000;
+        constexpr int registrars_count = 2;
+        constexpr int registrations_per_thread = 500;
+
+        auto permanent = std::make_shared<AtomicCountingObserver>();
+        s.register_observer(permanent);
+
+        std::atomic<int> failed_unregistrations{0};
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (int t = 0; t < notifiers_count; ++t)
+            {
+                threads.emplace_back([&s, t] {
+                    for (int i = 1; i <= notifications_per_thread; ++i)
+                        s.set_state(t * notifications_per_thread + i); // every state is new
+                });
+            }
+
+            for (int t = 0; t < registrars_count; ++t)
+            {
+                threads.emplace_back([&s, &failed_unregistrations] {
+                    for (int i = 0; i < registrations_per_thread; ++i)
+                    {
+                        auto temporary = std::make_shared<AtomicCountingObserver>();
+                        s.register_observer(temporary);
+                        if (!s.unregister_observer(temporary))
+                            ++failed_unregistrations;
+                    } // temporary may be destroyed by a notifier that still holds a snapshot
+                });
+            }
+        }
+
+        REQUIRE(failed_unregistrations == 0);
+        REQUIRE(permanent->updates_count == notifiers_count * notifications_per_thread);
+        REQUIRE(s.observers_count() == 1);
+    }
+}
+
+namespace
+{
+    // baseline - a registry guarded by a mutex held during a notification
+    class LockedSubject
+    {
+        std::atomic<int> state_{0};
+        std::mutex mtx_;
+        std::vector<std::shared_ptr<Observer>> observers_;
+
+    public:
+        void register_observer(std::shared_ptr<Observer> observer)
+        {
+            std::lock_guard lk{mtx_};
+            observers_.push_back(std::move(observer));
+        }
+
+        bool unregister_observer(const std::shared_ptr<Observer>& observer)
+        {
+            std::lock_guard lk{mtx_};
+
+            auto it = std::find(observers_.begin(), observers_.end(), observer);
+            if (it == observers_.end())
+                return false;
+
+            *it = std::move(observers_.back());
+            observers_.pop_back();
+            return true;
+        }
+
+        void set_state(int new_state)
+        {
+            if (state_.exchange(new_state, std::memory_order_relaxed) == new_state)
+                return;
+
+            thread_local std::string event_text;
+            const StateChanged event{new_state, event_text};
+
+            std::lock_guard lk{mtx_};
+            for (const std::shared_ptr<Observer>& observer : observers_)
+                observer->on_state_changed(event);
+        }
+    };
+
+    template <typename TSubject>
+    void notify_concurrently(TSubject& subject, unsigned notifiers_count, int notifications_per_thread, bool with_registrar)
+    {
+        std::atomic<bool> done{false};
+        std::jthread registrar;
+
+        if (with_registrar)
+        {
+            registrar = std::jthread{[&subject, &done] {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    auto temporary = std::make_shared<AtomicCountingObserver>();
+                    subject.register_observer(temporary);
+                    subject.unregister_observer(temporary);
+                    std::this_thread::yield();
+                }
+            }};
+        }
+
+        {
+            std::vector<std::jthread> notifiers;
+            for (unsigned t = 0; t < notifiers_count; ++t)
+            {
+                notifiers.emplace_back([&subject, t, notifications_per_thread] {
+                    for (int i = 1; i <= notifications_per_thread; ++i)
+                        subject.set_state(static_cast<int>(t) * notifications_per_thread + i);
+                });
+            }
+        }
+
+        done = true;
+    }
+} // namespace
+
+TEST_CASE("thread-safe subject - scaling", "[.][benchmark]")
+{
+    constexpr int observers_count = 100;
+    constexpr int notifications_per_thread = 1'000;
+
+    std::vector<std::shared_ptr<Observer>> observers;
+    for (int i = 0; i < observers_count; ++i)
+        observers.push_back(std::make_shared<AtomicCountingObserver>()); // notified by many threads at once
+
+    LockedSubject locked_subject;
+    Ver_5::Subject snapshot_subject;
+    for (const auto& observer : observers)
+    {
+        locked_subject.register_observer(observer);
+        snapshot_subject.register_observer(observer);
+    }
+
+    for (unsigned notifiers_count : {1u, 2u, 4u, 8u})
+    {
+        const std::string suffix = " - notifiers: " + std::to_string(notifiers_count);
+
+        BENCHMARK("std::mutex" + suffix)
+        {
+            notify_concurrently(locked_subject, notifiers_count, notifications_per_thread, false);
+        };
+
+        BENCHMARK("snapshot" + suffix)
+        {
+            notify_concurrently(snapshot_subject, notifiers_count, notifications_per_thread, false);
+        };
+
+        BENCHMARK("std::mutex + registrations" + suffix)
+        {
+            notify_concurrently(locked_subject, notifiers_count, notifications_per_thread, true);
+        };
+
+        BENCHMARK("snapshot + registrations" + suffix)
+        {
+            notify_concurrently(snapshot_subject, notifiers_count, notifications_per_thread, true);
+        };
+    }
 }
@@ -0,0 +1,316 @@
+#ifndef STACK_HPP
+#define STACK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// items are constructed in an inactive union member - allowed in constant evaluation
+// by gcc, but clang accepts it only with trivial unions (P3074, C++26)
+#if defined(__cpp_trivial_union) || (defined(__GNUC__) && !defined(__clang__))
+#define STATIC_VECTOR_CONSTEXPR constexpr
+#define STATIC_VECTOR_IS_CONSTEXPR 1
+#else
+#define STATIC_VECTOR_CONSTEXPR
+#define STATIC_VECTOR_IS_CONSTEXPR 0
+#endif
+
+////////////////////////////////////////////////////////////////
+// Fixed capacity container - items are stored inline, nothing is allocated on the heap
+// (can be used as TContainer of Stack)
+template <typename T, std::size_t N>
+class StaticVector
+{
+    union
+    {
+        T items_[N]; // members of a union are not constructed - lifetime of items is managed manually
+    };
+    std::size_t size_{};
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr StaticVector() noexcept
+    {
+    }
+
+    STATIC_VECTOR_CONSTEXPR StaticVector(const StaticVector& other) requires std::is_copy_constructible_v<T>
+        : StaticVector()
+    {
+        for (const T& item : other)
+            emplace_back(item);
+    }
+
+    STATIC_VECTOR_CONSTEXPR StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : StaticVector()
+    {
+        for (T& item : other)
+            emplace_back(std::move(item));
+        other.clear();
+    }
+
+    STATIC_VECTOR_CONSTEXPR StaticVector& operator=(const StaticVector& other) requires std::is_copy_constructible_v<T>
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const T& item : other)
+                emplace_back(item);
+        }
+
+        return *this;
+    }
+
+    STATIC_VECTOR_CONSTEXPR StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (T& item : other)
+                emplace_back(std::move(item));
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    STATIC_VECTOR_CONSTEXPR ~StaticVector()
+    {
+        clear();
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    template <typename... TArgs>
+    STATIC_VECTOR_CONSTEXPR T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == N)
+            throw std::length_error("StaticVector - capacity exceeded");
+
+        T* item = std::construct_at(&items_[size_], std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    STATIC_VECTOR_CONSTEXPR void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    STATIC_VECTOR_CONSTEXPR void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    // capacity of a sized range is checked once - no items are added if it does not fit
+    template <typename TRange>
+    STATIC_VECTOR_CONSTEXPR void append_range(TRange&& range)
+    {
+        if constexpr (std::ranges::sized_range<TRange>)
+        {
+            if (std::ranges::size(range) > N - size_)
+                throw std::length_error("StaticVector - capacity exceeded");
+
+            for (auto&& item : range)
+            {
+                std::construct_at(&items_[size_], std::forward<decltype(item)>(item));
+                ++size_;
+            }
+        }
+        else
+        {
+            for (auto&& item : range)
+                emplace_back(std::forward<decltype(item)>(item));
+        }
+    }
+
+    STATIC_VECTOR_CONSTEXPR void pop_back()
+    {
+        std::destroy_at(&items_[--size_]);
+    }
+
+    STATIC_VECTOR_CONSTEXPR iterator erase(const_iterator first, const_iterator last)
+    {
+        iterator target = begin() + (first - begin());
+        const std::size_t count = last - first;
+
+        std::move(target + count, end(), target);
+        for (std::size_t i = 0; i < count; ++i)
+            pop_back();
+
+        return target;
+    }
+
+    STATIC_VECTOR_CONSTEXPR void clear() noexcept
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    constexpr T& back()
+    {
+        return items_[size_ - 1];
+    }
+
+    constexpr const T& back() const
+    {
+        return items_[size_ - 1];
+    }
+
+    constexpr iterator begin() noexcept
+    {
+        return items_;
+    }
+
+    constexpr iterator end() noexcept
+    {
+        return items_ + size_;
+    }
+
+    constexpr const_iterator begin() const noexcept
+    {
+        return items_;
+    }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return items_ + size_;
+    }
+};
+
+////////////////////////////////////////////////////////////////
+template <typename T, typename TContainer = std::vector<T>>
+class Stack
+{
+    TContainer items_;
+
+public:
+    constexpr Stack() = default;
+
+    template <typename TValue>
+    constexpr void push(TValue&& value)
+    {
+        items_.push_back(std::forward<TValue>(value));
+    }
+
+    template <typename... TArgs>
+    constexpr void emplace(TArgs&&... args)
+    {
+        items_.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    constexpr T& top()
+    {
+        return items_.back();
+    }
+
+    constexpr const T& top() const
+    {
+        return items_.back();
+    }
+
+    constexpr void pop()
+    {
+        items_.pop_back();
+    }
+
+    // pushes all items of a range in one pass - items of an rvalue container are moved;
+    // views & borrowed ranges do not own their items, so they are copied
+    template <typename TRange>
+    constexpr void push_range(TRange&& range)
+    {
+        if constexpr (std::is_lvalue_reference_v<TRange> || std::ranges::view<std::remove_cvref_t<TRange>> || std::ranges::borrowed_range<TRange>)
+            append(range);
+        else if constexpr (std::ranges::common_range<TRange>)
+            append(std::ranges::subrange(std::make_move_iterator(std::ranges::begin(range)),
+                                         std::make_move_iterator(std::ranges::end(range))));
+        else
+            append(std::ranges::subrange(std::make_move_iterator(std::ranges::begin(range)),
+                                         std::move_sentinel(std::ranges::end(range))));
+    }
+
+    // moves up to count items from the top to out (in order of popping) & removes them at once
+    template <typename TOutputIterator>
+    constexpr TOutputIterator pop_n(std::size_t count, TOutputIterator out)
+    {
+        count = std::min(count, size());
+
+        auto last = items_.end();
+        auto first = std::prev(last, count);
+
+        out = std::move(std::make_reverse_iterator(last), std::make_reverse_iterator(first), out);
+        items_.erase(first, last);
+
+        return out;
+    }
+
+    // pops all items - returned in order of popping
+    constexpr std::vector<T> drain()
+    {
+        std::vector<T> items;
+        items.reserve(size());
+        pop_n(size(), std::back_inserter(items));
+
+        return items;
+    }
+
+    constexpr bool empty() const
+    {
+        return items_.empty();
+    }
+
+    constexpr std::size_t size() const
+    {
+        return items_.size();
+    }
+
+private:
+    template <typename TRange>
+    constexpr void append(TRange&& range)
+    {
+        if constexpr (requires { items_.append_range(range); })
+        {
+            items_.append_range(range);
+        }
+        else if constexpr (std::ranges::common_range<TRange>)
+        {
+            items_.insert(items_.end(), std::ranges::begin(range), std::ranges::end(range)); // single reservation for forward ranges
+        }
+        else
+        {
+            for (auto&& item : range)
+                items_.push_back(std::forward<decltype(item)>(item));
+        }
+    }
+};
+
+// stack with a known maximum depth - no heap allocations
+template <typename T, std::size_t N>
+using StaticStack = Stack<T, StaticVector<T, N>>;
+
+#endif
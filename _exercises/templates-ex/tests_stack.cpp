@@ -1,167 +1,446 @@
+#include "allocation_counter.hpp"
+#include "stack.hpp"
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("After construction", "[stack,constructors]")
+{
+    Stack<int> s;
+
+    SECTION("is empty")
+    {
+        REQUIRE(s.empty());
+    }
+
+    SECTION("size is zero")
+    {
+        REQUIRE(s.size() == 0);
+    }
+}
+
+TEST_CASE("Pushing an item", "[stack,push]")
+{
+    Stack<int> s;
+
+    SECTION("is no longer empty")
+    {
+        s.push(1);
+
+        REQUIRE(!s.empty());
+    }
 
-// TEST_CASE("After construction", "[stack,constructors]")
-// {
-//     Stack<int> s;
+    SECTION("size is increased")
+    {
+        auto size_before = s.size();
 
-//     SECTION("is empty")
-//     {
-//         REQUIRE(s.empty());
-//     }
+        s.push(1);
 
-//     SECTION("size is zero")
-//     {
-//         REQUIRE(s.size() == 0);
-//     }
-// }
+        REQUIRE(s.size() - size_before == 1);
+    }
 
-// TEST_CASE("Pushing an item", "[stack,push]")
-// {
-//     Stack<int> s;
+    SECTION("recently pushed item is on a top")
+    {
+        s.push(4);
 
-//     SECTION("is no longer empty")
-//     {
-//         s.push(1);
+        REQUIRE(s.top() == 4);
+    }
+}
 
-//         REQUIRE(!s.empty());
-//     }
+template <typename T, typename TContainer>
+std::vector<T> pop_all(Stack<T, TContainer>& s)
+{
+    std::vector<T> values(s.size());
 
-//     SECTION("size is increased")
-//     {
-//         auto size_before = s.size();
+    for (auto& item : values)
+    {
+        item = std::move(s.top());
+        s.pop();
+    }
 
-//         s.push(1);
+    return values;
+}
 
-//         REQUIRE(s.size() - size_before == 1);
-//     }
+TEST_CASE("Popping an item", "[stack,pop]")
+{
+    Stack<int> s;
 
-//     SECTION("recently pushed item is on a top")
-//     {
-//         s.push(4);
+    s.push(1);
+    s.push(4);
 
-//         REQUIRE(s.top() == 4);
-//     }
-// }
+    int item;
 
-// template <typename T>
-// std::vector<T> pop_all(Stack<T>& s)
-// {
-//     std::vector<T> values(s.size());
+    SECTION("assignes an item from a top to an argument passed by ref")
+    {
+        item = s.top();
+        s.pop();
 
-//     for (auto& item : values)
-//     {
-//         item = std::move(s.top());
-//         s.pop();
-//     }
+        REQUIRE(item == 4);
+    }
 
-//     return values;
-// }
+    SECTION("size is decreased")
+    {
+        size_t size_before = s.size();
 
-// TEST_CASE("Popping an item", "[stack,pop]")
-// {
-//     Stack<int> s;
+        item = s.top();
+        s.pop();
 
-//     s.push(1);
-//     s.push(4);
 
-//     int item;
+        REQUIRE(size_before - s.size() == 1);
+    }
 
-//     SECTION("assignes an item from a top to an argument passed by ref")
-//     {
-//         item = s.top();
-//         s.pop();
+    SECTION("LIFO order")
+    {
+        int a, b;
 
-//         REQUIRE(item == 4);
-//     }
+        a = s.top();
+        s.pop();
 
-//     SECTION("size is decreased")
-//     {
-//         size_t size_before = s.size();
+        b = s.top();
+        s.pop();
 
-//         item = s.top();
-//         s.pop();
 
+        REQUIRE(a == 4);
+        REQUIRE(b == 1);
+    }
+}
 
-//         REQUIRE(size_before - s.size() == 1);
-//     }
+TEST_CASE("Move semantics", "[stack,push,pop,move]")
+{
+    using namespace std::literals;
 
-//     SECTION("LIFO order")
-//     {
-//         int a, b;
+    SECTION("stores move-only objects")
+    {
+        auto txt1 = std::make_unique<std::string>("test1");
 
-//         a = s.top();
-//         s.pop();
+        Stack<std::unique_ptr<std::string>> s;
 
-//         b = s.top();
-//         s.pop();
+        s.push(move(txt1));
+        s.push(std::make_unique<std::string>("test2"));
 
+        std::unique_ptr<std::string> value;
 
-//         REQUIRE(a == 4);
-//         REQUIRE(b == 1);
-//     }
-// }
+        value = std::move(s.top());
+        s.pop();
+        REQUIRE(*value == "test2"s);
 
-// TEST_CASE("Move semantics", "[stack,push,pop,move]")
-// {
-//     using namespace std::literals;
+        value = std::move(s.top());
+        s.pop();
+        REQUIRE(*value == "test1"s);
+    }
 
-//     SECTION("stores move-only objects")
-//     {
-//         auto txt1 = std::make_unique<std::string>("test1");
+    SECTION("move constructor", "[stack,move]")
+    {
+        Stack<std::unique_ptr<std::string>> s;
 
-//         Stack<std::unique_ptr<std::string>> s;
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
 
-//         s.push(move(txt1));
-//         s.push(std::make_unique<std::string>("test2"));
+        auto moved_s = std::move(s);
 
-//         std::unique_ptr<std::string> value;
+        auto values = pop_all(moved_s);
 
-//         value = std::move(s.top());
-//         s.pop();
-//         REQUIRE(*value == "test2"s);
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
 
-//         value = std::move(s.top());
-//         s.pop();
-//         REQUIRE(*value == "test1"s);
-//     }
+    SECTION("move assignment", "[stack,move]")
+    {
+        Stack<std::unique_ptr<std::string>> s;
 
-//     SECTION("move constructor", "[stack,move]")
-//     {
-//         Stack<std::unique_ptr<std::string>> s;
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
 
-//         s.push(std::make_unique<std::string>("txt1"));
-//         s.push(std::make_unique<std::string>("txt2"));
-//         s.push(std::make_unique<std::string>("txt3"));
+        Stack<std::unique_ptr<std::string>> target;
+        target.push(std::make_unique<std::string>("x"));
 
-//         auto moved_s = std::move(s);
+        target = std::move(s);
 
-//         auto values = pop_all(moved_s);
+        REQUIRE(target.size() == 3);
 
-//         auto expected = {"txt3", "txt2", "txt1"};
-//         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
-//     }
+        auto values = pop_all(target);
 
-//     SECTION("move assignment", "[stack,move]")
-//     {
-//         Stack<std::unique_ptr<std::string>> s;
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
+}
 
-//         s.push(std::make_unique<std::string>("txt1"));
-//         s.push(std::make_unique<std::string>("txt2"));
-//         s.push(std::make_unique<std::string>("txt3"));
+namespace
+{
+    STATIC_VECTOR_CONSTEXPR int sum_of_popped()
+    {
+        StaticStack<int, 8> s;
+        for (int i = 1; i <= 4; ++i)
+            s.push(i);
 
-//         Stack<std::unique_ptr<std::string>> target;
-//         target.push(std::make_unique<std::string>("x"));
+        int sum = 0;
+        while (!s.empty())
+        {
+            sum += s.top();
+            s.pop();
+        }
 
-//         target = std::move(s);
+        return sum;
+    }
+} // namespace
 
-//         REQUIRE(target.size() == 3);
+TEST_CASE("StaticStack", "[stack,static]")
+{
+    using namespace std::literals;
 
-//         auto values = pop_all(target);
+#if STATIC_VECTOR_IS_CONSTEXPR
+    SECTION("usable in constant expressions")
+    {
+        static_assert(sum_of_popped() == 10);
+    }
+#endif
 
-//         auto expected = {"txt3", "txt2", "txt1"};
-//         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
-//     }
-// }
\ No newline at end of file
+    SECTION("storage is inline")
+    {
+        static_assert(sizeof(StaticStack<int, 16>) >= 16 * sizeof(int));
+        static_assert(!std::is_copy_constructible_v<StaticStack<std::unique_ptr<int>, 4>>);
+    }
+
+    SECTION("no heap allocations")
+    {
+        Stack<int> heap_stack;
+        StaticStack<int, 64> static_stack;
+
+        const auto allocations_before = Helpers::AllocationCounter::allocations;
+        for (int i = 0; i < 64; ++i)
+            static_stack.push(i);
+        while (!static_stack.empty())
+            static_stack.pop();
+        REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+
+        for (int i = 0; i < 64; ++i)
+            heap_stack.push(i);
+        REQUIRE(Helpers::AllocationCounter::allocations > allocations_before);
+    }
+
+    SECTION("throws when capacity is exceeded")
+    {
+        StaticStack<int, 2> s;
+        s.push(1);
+        s.push(2);
+
+        REQUIRE_THROWS_AS(s.push(3), std::length_error);
+        REQUIRE(s.size() == 2);
+    }
+
+    SECTION("stores move-only objects")
+    {
+        StaticStack<std::unique_ptr<std::string>, 4> s;
+
+        s.push(std::make_unique<std::string>("txt1"));
+        s.emplace(new std::string("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
+
+        auto moved_s = std::move(s);
+        REQUIRE(s.empty());
+
+        StaticStack<std::unique_ptr<std::string>, 4> target;
+        target.push(std::make_unique<std::string>("x"));
+        target = std::move(moved_s);
+
+        REQUIRE(target.size() == 3);
+
+        auto values = pop_all(target);
+
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
+}
+
+TEST_CASE("Bulk operations", "[stack,bulk]")
+{
+    using namespace std::literals;
+
+    SECTION("push_range pushes items in order of a range")
+    {
+        Stack<int> s;
+        s.push(0);
+
+        const std::vector<int> items = {1, 2, 3};
+        s.push_range(items);
+
+        REQUIRE(s.size() == 4);
+        REQUIRE(s.top() == 3);
+        REQUIRE(items.size() == 3);
+    }
+
+    SECTION("push_range moves items of an rvalue range")
+    {
+        std::vector<std::unique_ptr<std::string>> items;
+        items.push_back(std::make_unique<std::string>("txt1"));
+        items.push_back(std::make_unique<std::string>("txt2"));
+
+        Stack<std::unique_ptr<std::string>> s;
+        s.push_range(std::move(items));
+
+        REQUIRE(s.size() == 2);
+        REQUIRE(*s.top() == "txt2"s);
+    }
+
+    SECTION("push_range copies items of views")
+    {
+        std::vector<std::string> items = {"one"s, "two"s, "three"s};
+
+        Stack<std::string> s;
+        s.push_range(std::span(items));
+        s.push_range(items | std::views::take(2));
+
+        REQUIRE(s.size() == 5);
+        REQUIRE(s.top() == "two"s);
+        REQUIRE(items == std::vector<std::string>{"one"s, "two"s, "three"s});
+    }
+
+    SECTION("push_range accepts non-common ranges")
+    {
+        Stack<int> s;
+        s.push_range(std::views::iota(1) | std::views::take_while([](int x) { return x <= 5; }));
+
+        REQUIRE(s.size() == 5);
+        REQUIRE(s.top() == 5);
+    }
+
+    SECTION("pop_n moves items in order of popping")
+    {
+        Stack<int> s;
+        s.push_range(std::array{1, 2, 3, 4});
+
+        std::vector<int> popped;
+        s.pop_n(3, std::back_inserter(popped));
+
+        REQUIRE(popped == std::vector{4, 3, 2});
+        REQUIRE(s.size() == 1);
+        REQUIRE(s.top() == 1);
+    }
+
+    SECTION("pop_n stops when the stack is empty")
+    {
+        Stack<int> s;
+        s.push_range(std::array{1, 2});
+
+        std::vector<int> popped;
+        s.pop_n(5, std::back_inserter(popped));
+
+        REQUIRE(popped == std::vector{2, 1});
+        REQUIRE(s.empty());
+    }
+
+    SECTION("drain")
+    {
+        StaticStack<std::unique_ptr<std::string>, 4> s;
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
+
+        auto values = s.drain();
+
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+        REQUIRE(s.empty());
+    }
+
+    SECTION("transfer between stacks")
+    {
+        Stack<int> source;
+        source.push_range(std::array{1, 2, 3});
+
+        StaticStack<int, 8> target;
+        target.push_range(source.drain());
+
+        REQUIRE(source.empty());
+        REQUIRE(target.size() == 3);
+        REQUIRE(target.top() == 1);
+    }
+
+    SECTION("StaticStack - range that does not fit is rejected as a whole")
+    {
+        StaticStack<int, 4> s;
+        s.push(0);
+
+        REQUIRE_THROWS_AS(s.push_range(std::array{1, 2, 3, 4}), std::length_error);
+        REQUIRE(s.size() == 1);
+    }
+
+    SECTION("StaticStack - pop_n from the middle of storage")
+    {
+        StaticStack<std::string, 8> s;
+        s.push_range(std::array{"one"s, "two"s, "three"s});
+
+        std::vector<std::string> popped;
+        s.pop_n(2, std::back_inserter(popped));
+
+        REQUIRE(popped == std::vector{"three"s, "two"s});
+        REQUIRE(s.top() == "one"s);
+    }
+}
+
+namespace
+{
+    template <typename TStack>
+    void benchmark_transfer(const std::string& name, std::size_t size)
+    {
+        const std::string suffix = " - " + name + " - size: " + std::to_string(size);
+
+        std::vector<int> items(size);
+        std::iota(items.begin(), items.end(), 0);
+
+        BENCHMARK_ADVANCED("element-wise transfer" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            TStack source;
+            source.push_range(items);
+
+            meter.measure([&] {
+                TStack target;
+                while (!source.empty())
+                {
+                    target.push(std::move(source.top()));
+                    source.pop();
+                }
+                while (!target.empty()) // restores source for the next run
+                {
+                    source.push(std::move(target.top()));
+                    target.pop();
+                }
+                return source.size();
+            });
+        };
+
+        BENCHMARK_ADVANCED("bulk transfer" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            TStack source;
+            source.push_range(items);
+
+            meter.measure([&] {
+                TStack target;
+                target.push_range(source.drain());
+                source.push_range(target.drain());
+                return source.size();
+            });
+        };
+    }
+} // namespace
+
+TEST_CASE("Stack - bulk operations", "[.][benchmark]")
+{
+    for (std::size_t size : {16u, 1'024u, 64u * 1'024u})
+        benchmark_transfer<Stack<int>>("Stack<int>", size);
+
+    benchmark_transfer<StaticStack<int, 1'024>>("StaticStack<int, 1024>", 1'024);
+}
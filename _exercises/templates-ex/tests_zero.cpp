@@ -1,7 +1,16 @@
 #include <algorithm>
+#include <array>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <list>
+#include <memory>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace Exercise
@@ -68,17 +77,79 @@ namespace Exercise
 
     inline namespace Ver_4
     {
+        // true if a value-initialized T is represented by all-bits-zero
+        // (can be specialized for user defined types)
+        template <typename T>
+        struct is_zero_bits : std::bool_constant<std::is_scalar_v<T> && !std::is_member_pointer_v<T>>
+        { };
+
+        template <typename T, std::size_t N>
+        struct is_zero_bits<T[N]> : is_zero_bits<T>
+        { };
+
+        template <typename T>
+        constexpr bool is_zero_bits_v = is_zero_bits<T>::value;
+
         template <typename TContainer>
-        void zero(TContainer& container)
+        concept MemsetZeroable = requires(TContainer& container) { std::begin(container); }
+            && std::contiguous_iterator<decltype(std::begin(std::declval<TContainer&>()))>
+            && std::is_trivially_default_constructible_v<std::iter_value_t<decltype(std::begin(std::declval<TContainer&>()))>>
+            && std::is_trivially_copyable_v<std::iter_value_t<decltype(std::begin(std::declval<TContainer&>()))>>
+            && is_zero_bits_v<std::iter_value_t<decltype(std::begin(std::declval<TContainer&>()))>>
+            && !std::is_const_v<std::remove_reference_t<decltype(*std::begin(std::declval<TContainer&>()))>>;
+
+        // below this size memset is memory bound on a single core anyway
+        inline constexpr std::size_t parallel_zero_threshold = 32 * 1024 * 1024;
+
+        // memset of a large buffer is split into page aligned chunks zeroed by thread_count threads
+        inline void zero_bytes(void* data, std::size_t size,
+                               std::size_t threshold = parallel_zero_threshold,
+                               unsigned thread_count = std::thread::hardware_concurrency())
         {
-            using TValue = std::remove_reference_t<decltype(*std::begin(container))>;            
+            if (size == 0)
+                return;
 
-            std::fill(std::begin(container), std::end(container), TValue{});
+            if (size < threshold || thread_count < 2)
+            {
+                std::memset(data, 0, size);
+                return;
+            }
 
-            // memset - for native tables & POD types ???
+            constexpr std::size_t page_size = 4096;
+            const std::size_t chunk_size = ((size / thread_count + page_size - 1) / page_size) * page_size;
+
+            auto* bytes = static_cast<std::byte*>(data);
+            const std::size_t head = (page_size - reinterpret_cast<std::uintptr_t>(data) % page_size) % page_size;
+
+            std::vector<std::jthread> threads;
+            std::size_t offset = 0;
+            for (std::size_t end = head + chunk_size; end < size; offset = end, end += chunk_size) // chunk ends are page aligned
+            {
+                threads.emplace_back([chunk = bytes + offset, length = end - offset] { std::memset(chunk, 0, length); });
+            }
+
+            std::memset(bytes + offset, 0, size - offset); // last chunk - calling thread
         }
-    } // namespace Ver_3
 
+        template <typename TContainer>
+        void zero(TContainer& container)
+        {
+            using TValue = std::remove_reference_t<decltype(*std::begin(container))>;
+
+            if constexpr (MemsetZeroable<TContainer>)
+            {
+                auto first = std::begin(container);
+                auto last = std::end(container);
+
+                if (first != last)
+                    zero_bytes(std::to_address(first), (last - first) * sizeof(TValue));
+            }
+            else
+            {
+                std::fill(std::begin(container), std::end(container), TValue{});
+            }
+        }
+    } // namespace Ver_4
 
 } // namespace Exercise
 
@@ -121,4 +192,123 @@ TEST_CASE("zero - Step 1")
 
         REQUIRE(std::all_of(std::begin(tab), std::end(tab), [](int x) { return x == 0; }));
     }
-}
\ No newline at end of file
+}
+
+namespace
+{
+    struct Vec3
+    {
+        double x, y, z;
+
+        bool operator==(const Vec3&) const = default;
+    };
+}
+
+template <>
+struct Exercise::is_zero_bits<Vec3> : std::true_type
+{ };
+
+TEST_CASE("zero - memset for trivial types")
+{
+    using namespace Exercise;
+
+    static_assert(MemsetZeroable<std::vector<int>>);
+    static_assert(MemsetZeroable<std::array<double, 4>>);
+    static_assert(MemsetZeroable<int[4]>);
+    static_assert(MemsetZeroable<std::vector<Vec3>>);
+    static_assert(MemsetZeroable<std::vector<int*>>);
+    static_assert(!MemsetZeroable<std::list<int>>);
+    static_assert(!MemsetZeroable<std::vector<std::string>>);
+    static_assert(!MemsetZeroable<std::vector<bool>>);
+    static_assert(!MemsetZeroable<std::vector<int Vec3::*>>); // null member pointer is not all-bits-zero
+
+    SECTION("vector<double>")
+    {
+        std::vector<double> vec = {1.0, -2.5, 3.14};
+
+        zero(vec);
+
+        REQUIRE(vec == std::vector{0.0, 0.0, 0.0});
+    }
+
+    SECTION("array<int*>")
+    {
+        int x = 42;
+        std::array<int*, 3> ptrs = {&x, &x, &x};
+
+        zero(ptrs);
+
+        REQUIRE(std::all_of(ptrs.begin(), ptrs.end(), [](int* p) { return p == nullptr; }));
+    }
+
+    SECTION("vector<Vec3>")
+    {
+        std::vector<Vec3> points = {{1, 2, 3}, {4, 5, 6}};
+
+        zero(points);
+
+        REQUIRE(points == std::vector<Vec3>{{0, 0, 0}, {0, 0, 0}});
+    }
+
+    SECTION("empty vector")
+    {
+        std::vector<int> vec;
+
+        zero(vec);
+
+        REQUIRE(vec.empty());
+    }
+}
+
+TEST_CASE("zero - parallel chunks")
+{
+    std::vector<unsigned char> buffer(3 * 4096 + 17, 0xFF);
+
+    Exercise::zero_bytes(buffer.data(), buffer.size(), 0, 4);
+
+    REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](unsigned char b) { return b == 0; }));
+
+    SECTION("unaligned start")
+    {
+        std::fill(buffer.begin(), buffer.end(), 0xFF);
+
+        Exercise::zero_bytes(buffer.data() + 1, buffer.size() - 2, 0, 4);
+
+        REQUIRE(buffer.front() == 0xFF);
+        REQUIRE(buffer.back() == 0xFF);
+        REQUIRE(std::all_of(buffer.begin() + 1, buffer.end() - 1, [](unsigned char b) { return b == 0; }));
+    }
+}
+
+namespace
+{
+    template <typename T>
+    void benchmark_zero(const std::string& type_name)
+    {
+        for (std::size_t bytes : {4u * 1024u, 4u * 1024u * 1024u, 64u * 1024u * 1024u, 256u * 1024u * 1024u})
+        {
+            const std::string suffix = " - " + type_name + " - " + std::to_string(bytes / 1024) + " KB";
+
+            std::vector<T> data(bytes / sizeof(T));
+
+            BENCHMARK("std::fill" + suffix)
+            {
+                Exercise::Ver_3::zero(data);
+                return data.data();
+            };
+
+            BENCHMARK("zero" + suffix)
+            {
+                Exercise::zero(data);
+                return data.data();
+            };
+        }
+    }
+}
+
+TEST_CASE("zero", "[.][benchmark]")
+{
+    benchmark_zero<int>("int");
+    benchmark_zero<double>("double");
+    benchmark_zero<Vec3>("Vec3");
+}
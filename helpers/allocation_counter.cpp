@@ -0,0 +1,142 @@
+#include "allocation_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace Helpers::AllocationCounter
+{
+    thread_local std::size_t allocations = 0;
+}
+
+namespace
+{
+    void* allocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        ++Helpers::AllocationCounter::allocations;
+
+        if (size == 0)
+            size = 1;
+
+        if (alignment <= alignof(std::max_align_t))
+            return std::malloc(size);
+
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment); // size must be a multiple of alignment
+    }
+
+    void* allocate_or_throw(std::size_t size, std::size_t alignment)
+    {
+        while (true)
+        {
+            if (void* ptr = allocate(size, alignment))
+                return ptr;
+
+            if (std::new_handler handler = std::get_new_handler())
+                handler();
+            else
+                throw std::bad_alloc{};
+        }
+    }
+} // namespace
+
+////////////////////////////////////////////////////////////////
+// all forms of operator new allocate with malloc/aligned_alloc
+// & all forms of operator delete release with free
+void* operator new(std::size_t size)
+{
+    return allocate_or_throw(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate_or_throw(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,14 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+// link the allocation_counter target to replace global operator new & delete
+// in a test binary - every form of operator new is counted
+namespace Helpers::AllocationCounter
+{
+    // allocations made with global operator new by the current thread
+    extern thread_local std::size_t allocations;
+}
+
+#endif
@@ -6,8 +6,11 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <type_traits>
 
 #include "gadget.hpp"
+#include "sso_string.hpp"
+#include "string_stats.hpp"
 
 namespace Helpers
 {
@@ -26,51 +29,67 @@ namespace Helpers
         std::cout << "]" << std::endl;
     }
 
+    class String;
+
+    namespace Detail
+    {
+        struct StringConcat;
+    }
+
     class String
     {
         std::uint64_t id_;
         std::string value_;
 
+        friend struct Detail::StringConcat;
+
+        inline static const std::size_t small_capacity = std::string{}.capacity();
+
         static uint64_t gen_id()
         {
+            Detail::ThreadCounters<String>& counters = Detail::thread_counters<String>();
+            Detail::CounterShard::increment(counters.shard().constructed);
+
+            return counters.next_id();
+        }
+
+        // counters are sharded per thread - see string_stats.hpp
+        static void count(std::atomic<std::uint64_t> Detail::CounterShard::*counter)
+        {
+            Detail::CounterShard::increment(Detail::thread_counters<String>().shard().*counter);
+        }
 
-            return ++id_seed;
+        // heap allocation of value_ is detected by a growth of its capacity
+        static void count_allocation(std::size_t capacity_before, const std::string& value)
+        {
+            if (value.capacity() > capacity_before)
+                count(&Detail::CounterShard::allocations);
         }
 
-        inline static std::uint64_t id_seed{};
-        inline static std::uint64_t copy_constructor_count{};
-        inline static std::uint64_t move_constructor_count{};
-        inline static std::uint64_t copy_assignment_count{};
-        inline static std::uint64_t move_assignment_count{};
         inline static bool silent_mode{false};
 
     public:
+        static StringStats snapshot()
+        {
+            return Detail::CounterRegistry<String>::instance().snapshot();
+        }
+
         static void print_stats(std::string_view msg = "")
         {
-            std::cout << "==================================\n";
-            std::cout << "-- " << (msg.empty() ? "" : msg) << "\n";
-            std::cout << "----------------------------------\n";
-            std::cout << "constructed: " << id_seed << "\n";
-            std::cout << "copy constructed: " << copy_constructor_count << "\n";
-            std::cout << "move constructed: " << move_constructor_count << "\n";
-            std::cout << "copy assigned: " << copy_assignment_count << "\n";
-            std::cout << "move assigned: " << move_assignment_count << "\n";
-            std::cout << "==================================\n";
+            Helpers::print_stats(snapshot(), msg);
         }
 
         static void clear_stats()
         {
-            id_seed = 0;
-            copy_constructor_count = 0;
-            copy_assignment_count = 0;
-            move_constructor_count = 0;
-            move_assignment_count = 0;
+            Detail::CounterRegistry<String>::instance().reset();
         }
 
         String()
             : id_{gen_id()}
             , value_{std::string("default") + std::to_string(id_)}
         {
+            count_allocation(small_capacity, value_);
+
             #ifdef ENABLE_LOGGING_TO_CONSOLE
                 std::cout << "String(" << id_ << ", " << value_ << ")" << std::endl;
             #endif
@@ -80,6 +99,8 @@ namespace Helpers
             : id_{gen_id()}
             , value_{name}
         {
+            count_allocation(small_capacity, value_);
+
             #ifdef ENABLE_LOGGING_TO_CONSOLE
                 std::cout << "String(" << id_ << ", " << value_ << ")" << std::endl;
             #endif
@@ -88,6 +109,17 @@ namespace Helpers
         String(const std::string& name)
             : id_{gen_id()}
             , value_{name}
+        {
+            count_allocation(small_capacity, value_);
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "String(" << id_ << ", " << value_ << ")" << std::endl;
+            #endif
+        }
+
+        String(std::string&& name)
+            : id_{gen_id()}
+            , value_{std::move(name)}
         {
             #ifdef ENABLE_LOGGING_TO_CONSOLE
                 std::cout << "String(" << id_ << ", " << value_ << ")" << std::endl;
@@ -98,25 +130,29 @@ namespace Helpers
             : id_{source.id_}
             , value_{source.value_}
         {
+            count_allocation(small_capacity, value_);
+
             #ifdef ENABLE_LOGGING_TO_CONSOLE
                 std::cout << "String(cc: " << id_ << ", " << value_ << ")" << std::endl;
             #endif
-            ++copy_constructor_count;
+            count(&Detail::CounterShard::copy_constructed);
         }
 
         String& operator=(const String& source)
         {
             if (this != &source)
             {
+                const std::size_t capacity_before = value_.capacity();
                 id_ = source.id_;
                 value_ = source.value_;
+                count_allocation(capacity_before, value_);
             }
 
             #ifdef ENABLE_LOGGING_TO_CONSOLE
                 std::cout << "String(c=: " << id_ << ", " << value_ << ")" << std::endl;
             #endif
 
-            ++copy_assignment_count;
+            count(&Detail::CounterShard::copy_assigned);
 
             return *this;
         }
@@ -130,7 +166,7 @@ namespace Helpers
             #ifdef ENABLE_LOGGING_TO_CONSOLE
                 std::cout << "String(mv: " << id_ << ", " << value_ << ")" << std::endl;
             #endif
-            ++move_constructor_count;
+            count(&Detail::CounterShard::move_constructed);
         }
 
         String& operator=(String&& source)
@@ -145,7 +181,7 @@ namespace Helpers
                 std::cout << "String(m=: " << id_ << ", " << value_ << ")" << std::endl;
             #endif
 
-            ++move_assignment_count;
+            count(&Detail::CounterShard::move_assigned);
 
             return *this;
         }
@@ -163,9 +199,66 @@ namespace Helpers
         }
     };
 
+    namespace Detail
+    {
+        template <typename T>
+        constexpr bool IsString_v = std::is_same_v<std::decay_t<T>, String>;
+
+        struct StringConcat
+        {
+            // the total length is known up front - the result is built in one allocation;
+            // the buffer of the leftmost rvalue String is reused unless it is also one of the rest
+            // (std::move(s) + s would append an already moved-from s)
+            template <typename TFirst, typename... TRest>
+            static String concat(TFirst&& first, const TRest&... rest)
+            {
+                const std::size_t size = (first.value_.size() + ... + rest.value_.size());
+
+                std::string result;
+                std::size_t capacity_before = result.capacity();
+
+                bool reuse_first = false;
+                if constexpr (std::is_rvalue_reference_v<TFirst&&> && !std::is_const_v<std::remove_reference_t<TFirst>>)
+                    reuse_first = !((static_cast<const void*>(&rest) == static_cast<const void*>(&first)) || ...);
+
+                if (reuse_first)
+                {
+                    result = std::move(first.value_);
+                    capacity_before = result.capacity();
+                    result.reserve(size);
+                }
+                else
+                {
+                    result.reserve(size);
+                    result.append(first.value_);
+                }
+
+                (result.append(rest.value_), ...);
+
+                String::count_allocation(capacity_before, result);
+
+                return String{std::move(result)};
+            }
+        };
+    } // namespace Detail
+
+    // concat(a, b, c, d) - one allocation for the whole chain
+    template <typename TFirst, typename... TRest,
+              typename = std::enable_if_t<Detail::IsString_v<TFirst> && (Detail::IsString_v<TRest> && ...)>>
+    String concat(TFirst&& first, const TRest&... rest)
+    {
+        return Detail::StringConcat::concat(std::forward<TFirst>(first), rest...);
+    }
+
     inline String operator+(const String& lhs, const String& rhs)
     {
-        return String{lhs.value() + rhs.value()};
+        return concat(lhs, rhs);
+    }
+
+    // buffer of lhs is reused - a + b + c appends to the result of a + b
+    inline String operator+(String&& lhs, const String& rhs)
+    {
+        return concat(std::move(lhs), rhs);
     }
 
     inline std::ostream& operator<<(std::ostream& out, const String& g)
@@ -0,0 +1,280 @@
+#ifndef SSO_STRING_HPP
+#define SSO_STRING_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "string_stats.hpp"
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////////////
+    // Instrumented string (the same interface as String) with a small buffer
+    // optimization - values of up to InlineCapacity chars are stored inside the object,
+    // longer values get a heap buffer of the exact size
+    //
+    // sizeof(SsoString<15>) == 32; sizeof(String) == 40 with libstdc++
+    template <std::size_t InlineCapacity = 15>
+    class SsoString
+    {
+        std::uint64_t id_;
+        std::size_t size_{};
+        union
+        {
+            char inline_[InlineCapacity + 1];
+            char* heap_;
+        };
+
+        static uint64_t gen_id()
+        {
+            Detail::ThreadCounters<SsoString>& counters = Detail::thread_counters<SsoString>();
+            Detail::CounterShard::increment(counters.shard().constructed);
+
+            return counters.next_id();
+        }
+
+        static void count(std::atomic<std::uint64_t> Detail::CounterShard::*counter)
+        {
+            Detail::CounterShard::increment(Detail::thread_counters<SsoString>().shard().*counter);
+        }
+
+        bool is_inline() const noexcept
+        {
+            return size_ <= InlineCapacity;
+        }
+
+        // sets size & returns a buffer for size chars + '\0' - expects that no heap buffer is owned
+        char* allocate(std::size_t size)
+        {
+            size_ = size;
+
+            if (is_inline())
+                return inline_;
+
+            heap_ = new char[size + 1];
+            count(&Detail::CounterShard::allocations);
+            return heap_;
+        }
+
+        void deallocate() noexcept
+        {
+            if (!is_inline())
+                delete[] heap_;
+
+            size_ = 0;
+            inline_[0] = '\0';
+        }
+
+        void assign(std::string_view text)
+        {
+            char* buffer = allocate(text.size());
+            std::memcpy(buffer, text.data(), text.size());
+            buffer[text.size()] = '\0';
+        }
+
+        void steal(SsoString& source) noexcept
+        {
+            size_ = source.size_;
+
+            if (source.is_inline())
+                std::memcpy(inline_, source.inline_, size_ + 1);
+            else
+                heap_ = source.heap_;
+
+            source.size_ = 0;
+            source.inline_[0] = '\0';
+        }
+
+        struct Concat
+        { };
+
+        // used by operator+ - the result is formatted in a single buffer
+        SsoString(Concat, std::string_view lhs, std::string_view rhs)
+            : id_{gen_id()}
+        {
+            char* buffer = allocate(lhs.size() + rhs.size());
+            std::memcpy(buffer, lhs.data(), lhs.size());
+            std::memcpy(buffer + lhs.size(), rhs.data(), rhs.size());
+            buffer[size_] = '\0';
+        }
+
+    public:
+        static constexpr std::size_t inline_capacity = InlineCapacity;
+
+        static StringStats snapshot()
+        {
+            return Detail::CounterRegistry<SsoString>::instance().snapshot();
+        }
+
+        static void print_stats(std::string_view msg = "")
+        {
+            Helpers::print_stats(snapshot(), msg);
+        }
+
+        static void clear_stats()
+        {
+            Detail::CounterRegistry<SsoString>::instance().reset();
+        }
+
+        SsoString()
+            : id_{gen_id()}
+        {
+            // "default<id>" is formatted on the stack - no std::to_string() & concatenation temporaries
+            constexpr std::string_view prefix = "default";
+            char buffer[prefix.size() + std::numeric_limits<std::uint64_t>::digits10 + 1];
+
+            std::memcpy(buffer, prefix.data(), prefix.size());
+            const auto [end, ec] = std::to_chars(buffer + prefix.size(), buffer + sizeof(buffer), id_);
+            assign(std::string_view(buffer, end - buffer));
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "SsoString(" << id_ << ", " << value() << ")" << std::endl;
+            #endif
+        }
+
+        SsoString(const char* name)
+            : SsoString(std::string_view{name})
+        {
+        }
+
+        SsoString(const std::string& name)
+            : SsoString(std::string_view{name})
+        {
+        }
+
+        explicit SsoString(std::string_view name)
+            : id_{gen_id()}
+        {
+            assign(name);
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "SsoString(" << id_ << ", " << value() << ")" << std::endl;
+            #endif
+        }
+
+        SsoString(const SsoString& source)
+            : id_{source.id_}
+        {
+            assign(source.value());
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "SsoString(cc: " << id_ << ", " << value() << ")" << std::endl;
+            #endif
+            count(&Detail::CounterShard::copy_constructed);
+        }
+
+        SsoString& operator=(const SsoString& source)
+        {
+            if (this != &source)
+            {
+                if (source.is_inline())
+                {
+                    deallocate();
+                    assign(source.value());
+                }
+                else
+                {
+                    // allocation may throw - the state is not modified before
+                    char* buffer = new char[source.size_ + 1];
+                    count(&Detail::CounterShard::allocations);
+                    std::memcpy(buffer, source.heap_, source.size_ + 1);
+                    deallocate();
+                    size_ = source.size_;
+                    heap_ = buffer;
+                }
+
+                id_ = source.id_;
+            }
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "SsoString(c=: " << id_ << ", " << value() << ")" << std::endl;
+            #endif
+
+            count(&Detail::CounterShard::copy_assigned);
+
+            return *this;
+        }
+
+#ifdef ENABLE_MOVE_SEMANTICS
+
+        SsoString(SsoString&& source) noexcept
+            : id_{source.id_}
+        {
+            steal(source);
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "SsoString(mv: " << id_ << ", " << value() << ")" << std::endl;
+            #endif
+            count(&Detail::CounterShard::move_constructed);
+        }
+
+        SsoString& operator=(SsoString&& source) noexcept
+        {
+            if (this != &source)
+            {
+                deallocate();
+                id_ = source.id_;
+                steal(source);
+            }
+
+            #ifdef ENABLE_LOGGING_TO_CONSOLE
+                std::cout << "SsoString(m=: " << id_ << ", " << value() << ")" << std::endl;
+            #endif
+
+            count(&Detail::CounterShard::move_assigned);
+
+            return *this;
+        }
+
+#endif
+
+        ~SsoString() noexcept
+        {
+            deallocate();
+        }
+
+        uint64_t id() const
+        {
+            return id_;
+        }
+
+        std::string_view value() const noexcept
+        {
+            return std::string_view{c_str(), size_};
+        }
+
+        const char* c_str() const noexcept
+        {
+            return is_inline() ? inline_ : heap_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool is_small() const noexcept
+        {
+            return is_inline();
+        }
+
+        friend SsoString operator+(const SsoString& lhs, const SsoString& rhs)
+        {
+            return SsoString{Concat{}, lhs.value(), rhs.value()};
+        }
+    };
+
+    template <std::size_t InlineCapacity>
+    std::ostream& operator<<(std::ostream& out, const SsoString<InlineCapacity>& s)
+    {
+        out << "SsoString{id: " << s.id() << ", name: " << s.value() << "}";
+        return out;
+    }
+} // namespace Helpers
+
+#endif
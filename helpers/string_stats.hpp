@@ -0,0 +1,218 @@
+#ifndef STRING_STATS_HPP
+#define STRING_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+
+namespace Helpers
+{
+    struct StringStats
+    {
+        std::uint64_t constructed{};
+        std::uint64_t copy_constructed{};
+        std::uint64_t move_constructed{};
+        std::uint64_t copy_assigned{};
+        std::uint64_t move_assigned{};
+        std::uint64_t allocations{};
+
+        StringStats& operator+=(const StringStats& other) noexcept
+        {
+            constructed += other.constructed;
+            copy_constructed += other.copy_constructed;
+            move_constructed += other.move_constructed;
+            copy_assigned += other.copy_assigned;
+            move_assigned += other.move_assigned;
+            allocations += other.allocations;
+            return *this;
+        }
+    };
+
+    inline void print_stats(const StringStats& stats, std::string_view msg = "")
+    {
+        std::cout << "==================================\n";
+        std::cout << "-- " << (msg.empty() ? "" : msg) << "\n";
+        std::cout << "----------------------------------\n";
+        std::cout << "constructed: " << stats.constructed << "\n";
+        std::cout << "copy constructed: " << stats.copy_constructed << "\n";
+        std::cout << "move constructed: " << stats.move_constructed << "\n";
+        std::cout << "copy assigned: " << stats.copy_assigned << "\n";
+        std::cout << "move assigned: " << stats.move_assigned << "\n";
+        std::cout << "allocations: " << stats.allocations << "\n";
+        std::cout << "==================================\n";
+    }
+
+    namespace Detail
+    {
+        // fixed instead of std::hardware_destructive_interference_size - the latter is not ABI-stable
+        inline constexpr std::size_t cache_line_size = 64;
+
+        ////////////////////////////////////////////////////////////////
+        // counters of a single thread - written only by the owning thread,
+        // read by any thread that takes a snapshot
+        struct alignas(cache_line_size) CounterShard
+        {
+            std::atomic<std::uint64_t> constructed{};
+            std::atomic<std::uint64_t> copy_constructed{};
+            std::atomic<std::uint64_t> move_constructed{};
+            std::atomic<std::uint64_t> copy_assigned{};
+            std::atomic<std::uint64_t> move_assigned{};
+            std::atomic<std::uint64_t> allocations{};
+
+            // single writer - no need for a locked read-modify-write
+            static void increment(std::atomic<std::uint64_t>& counter) noexcept
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            StringStats load() const noexcept
+            {
+                return StringStats{
+                    constructed.load(std::memory_order_relaxed),
+                    copy_constructed.load(std::memory_order_relaxed),
+                    move_constructed.load(std::memory_order_relaxed),
+                    copy_assigned.load(std::memory_order_relaxed),
+                    move_assigned.load(std::memory_order_relaxed),
+                    allocations.load(std::memory_order_relaxed)};
+            }
+
+            void reset() noexcept
+            {
+                constructed.store(0, std::memory_order_relaxed);
+                copy_constructed.store(0, std::memory_order_relaxed);
+                move_constructed.store(0, std::memory_order_relaxed);
+                copy_assigned.store(0, std::memory_order_relaxed);
+                move_assigned.store(0, std::memory_order_relaxed);
+                allocations.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // registry of live shards + totals of threads that already finished
+        // TTag - instrumented class (every class gets its own set of counters)
+        template <typename TTag>
+        class CounterRegistry
+        {
+            std::mutex mtx_;
+            std::vector<CounterShard*> shards_;
+            StringStats retired_{};
+            std::atomic<std::uint64_t> id_seed_{};
+            std::atomic<std::uint64_t> id_generation_{};
+
+        public:
+            static constexpr std::uint64_t id_block_size = 1024;
+
+            static CounterRegistry& instance()
+            {
+                static CounterRegistry registry;
+                return registry;
+            }
+
+            void attach(CounterShard* shard)
+            {
+                std::lock_guard lk{mtx_};
+                shards_.push_back(shard);
+            }
+
+            void detach(CounterShard* shard)
+            {
+                std::lock_guard lk{mtx_};
+                retired_ += shard->load();
+                shards_.erase(std::remove(shards_.begin(), shards_.end(), shard), shards_.end());
+            }
+
+            StringStats snapshot()
+            {
+                std::lock_guard lk{mtx_};
+
+                StringStats total = retired_;
+                for (const CounterShard* shard : shards_)
+                    total += shard->load();
+
+                return total;
+            }
+
+            // expected to be called when no other thread is using Strings
+            void reset()
+            {
+                std::lock_guard lk{mtx_};
+
+                for (CounterShard* shard : shards_)
+                    shard->reset();
+                retired_ = StringStats{};
+
+                id_seed_.store(0, std::memory_order_relaxed);
+                id_generation_.fetch_add(1, std::memory_order_release);
+            }
+
+            std::uint64_t id_generation() const noexcept
+            {
+                return id_generation_.load(std::memory_order_acquire);
+            }
+
+            // returns first id of a block of id_block_size consecutive ids
+            std::uint64_t acquire_id_block() noexcept
+            {
+                return id_seed_.fetch_add(id_block_size, std::memory_order_relaxed) + 1;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // thread_local owner of a shard - ids are handed out from per-thread blocks
+        // so the shared id seed is touched once per id_block_size constructions
+        template <typename TTag>
+        class ThreadCounters
+        {
+            CounterShard shard_;
+            std::uint64_t next_id_{};
+            std::uint64_t end_id_{};
+            std::uint64_t id_generation_{};
+
+        public:
+            ThreadCounters()
+            {
+                CounterRegistry<TTag>::instance().attach(&shard_);
+            }
+
+            ThreadCounters(const ThreadCounters&) = delete;
+            ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+            ~ThreadCounters()
+            {
+                CounterRegistry<TTag>::instance().detach(&shard_);
+            }
+
+            CounterShard& shard() noexcept
+            {
+                return shard_;
+            }
+
+            std::uint64_t next_id() noexcept
+            {
+                CounterRegistry<TTag>& registry = CounterRegistry<TTag>::instance();
+
+                if (next_id_ == end_id_ || id_generation_ != registry.id_generation())
+                {
+                    id_generation_ = registry.id_generation();
+                    next_id_ = registry.acquire_id_block();
+                    end_id_ = next_id_ + CounterRegistry<TTag>::id_block_size;
+                }
+
+                return next_id_++;
+            }
+        };
+
+        template <typename TTag>
+        ThreadCounters<TTag>& thread_counters()
+        {
+            thread_local ThreadCounters<TTag> counters;
+            return counters;
+        }
+    } // namespace Detail
+} // namespace Helpers
+
+#endif
@@ -1,7 +1,9 @@
 #include "helpers.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <iostream>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////
 // Data - class with copy & move semantics (user provided implementation)
@@ -25,7 +27,21 @@ public:
         data_ = new int[list.size()];
         std::copy(list.begin(), list.end(), data_);
 
-        std::cout << "Data(" << name_ << ")\n";
+        #ifndef DISABLE_LOGGING_TO_CONSOLE
+            std::cout << "Data(" << name_ << ")\n";
+        #endif
+    }
+
+    Data(std::string name, size_t size, int value = 0)
+        : name_{std::move(name)}
+        , size_{size}
+    {
+        data_ = new int[size_];
+        std::fill_n(data_, size_, value);
+
+        #ifndef DISABLE_LOGGING_TO_CONSOLE
+            std::cout << "Data(" << name_ << ")\n";
+        #endif
     }
 
     // copy constructor
@@ -33,7 +49,9 @@ public:
         : name_(other.name_)
         , size_(other.size_)
     {
-        std::cout << "Data(" << name_ << ": cc)\n";
+        #ifndef DISABLE_LOGGING_TO_CONSOLE
+            std::cout << "Data(" << name_ << ": cc)\n";
+        #endif
         data_ = new int[size_];
         std::copy(other.begin(), other.end(), data_);
     }
@@ -44,7 +62,9 @@ public:
         Data temp(other);
         swap(temp);
 
-        std::cout << "Data=(" << name_ << ": cc)\n";
+        #ifndef DISABLE_LOGGING_TO_CONSOLE
+            std::cout << "Data=(" << name_ << ": cc)\n";
+        #endif
 
         return *this;
     }
@@ -55,7 +75,9 @@ public:
         other.data_ = nullptr;
         other.size_ = 0;
 
-        std::cout << "Data(" << name_ << ": mv)\n";
+        #ifndef DISABLE_LOGGING_TO_CONSOLE
+            std::cout << "Data(" << name_ << ": mv)\n";
+        #endif
     }
 
     // move assignment
@@ -77,7 +99,9 @@ public:
             other.size_ = 0;
         }
 
-        std::cout << "Data=(" << name_ << ": mv)\n";
+        #ifndef DISABLE_LOGGING_TO_CONSOLE
+            std::cout << "Data=(" << name_ << ": mv)\n";
+        #endif
 
         return *this;
     }
@@ -94,6 +118,11 @@ public:
         std::swap(size_, other.size_);
     }
 
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
     iterator begin() noexcept
     {
         return data_;
@@ -131,6 +160,14 @@ Data create_data_set()
     return ds;
 }
 
+Data create_data_set(size_t size)
+{
+    static int id_gen = 0;
+    const int id = ++id_gen;
+
+    return Data{"Data#" + std::to_string(id), size, id};
+}
+
 TEST_CASE("Data & move semantics")
 {
     Data ds1{"ds1", {1, 2, 3, 4, 5}};
@@ -232,4 +269,129 @@ TEST_CASE("noexcept")
 
     void (*ptr_fun1)(int) = foo;   
     // void (*ptr_fun2)(int) noexcept = bar; // ERROR
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Benchmarks - run with: bench-move-semantics "[benchmark]"
+
+namespace
+{
+    constexpr size_t payload_sizes[] = {16, 1'024, 64 * 1'024};
+}
+
+TEST_CASE("Data - copy vs. move", "[.][benchmark]")
+{
+    for (size_t size : payload_sizes)
+    {
+        const std::string suffix = " - payload: " + std::to_string(size);
+
+        BENCHMARK_ADVANCED("copy constructor" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            const Data source{"source", size, 42};
+            std::vector<Data> targets;
+            targets.reserve(meter.runs());
+
+            meter.measure([&] { targets.push_back(source); });
+        };
+
+        BENCHMARK_ADVANCED("move constructor" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<Data> sources;
+            sources.reserve(meter.runs());
+            for (int i = 0; i < meter.runs(); ++i)
+                sources.emplace_back("source", size, 42);
+
+            std::vector<Data> targets;
+            targets.reserve(meter.runs());
+
+            meter.measure([&](int i) { targets.push_back(std::move(sources[i])); });
+        };
+
+        BENCHMARK_ADVANCED("copy assignment" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            const Data source{"source", size, 42};
+            std::vector<Data> targets;
+            targets.reserve(meter.runs());
+            for (int i = 0; i < meter.runs(); ++i)
+                targets.emplace_back("target", size);
+
+            meter.measure([&](int i) { targets[i] = source; });
+        };
+
+        BENCHMARK_ADVANCED("move assignment" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<Data> sources;
+            std::vector<Data> targets;
+            sources.reserve(meter.runs());
+            targets.reserve(meter.runs());
+            for (int i = 0; i < meter.runs(); ++i)
+            {
+                sources.emplace_back("source", size, 42);
+                targets.emplace_back("target", size);
+            }
+
+            meter.measure([&](int i) { targets[i] = std::move(sources[i]); });
+        };
+    }
+}
+
+TEST_CASE("RuleOfZero::DataSet - forwarding constructor", "[.][benchmark]")
+{
+    using RuleOfZero::DataSet;
+
+    for (size_t size : payload_sizes)
+    {
+        const std::string suffix = " - payload: " + std::to_string(size);
+
+        BENCHMARK_ADVANCED("lvalue name & lvalue data" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            const std::string name = "DataSet with a name long enough to skip SSO";
+            const Data data{"data", size, 42};
+            std::vector<DataSet> data_sets;
+            data_sets.reserve(meter.runs());
+
+            meter.measure([&](int i) { data_sets.emplace_back(i, name, data); });
+        };
+
+        BENCHMARK_ADVANCED("rvalue name & rvalue data" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::string> names(meter.runs(), "DataSet with a name long enough to skip SSO");
+            std::vector<Data> data;
+            data.reserve(meter.runs());
+            for (int i = 0; i < meter.runs(); ++i)
+                data.emplace_back("data", size, 42);
+
+            std::vector<DataSet> data_sets;
+            data_sets.reserve(meter.runs());
+
+            meter.measure([&](int i) { data_sets.emplace_back(i, std::move(names[i]), std::move(data[i])); });
+        };
+    }
+}
+
+TEST_CASE("vector<Data> - growth", "[.][benchmark]")
+{
+    constexpr int count = 1'000;
+
+    for (size_t size : payload_sizes)
+    {
+        const std::string suffix = " - payload: " + std::to_string(size);
+
+        BENCHMARK("push_back" + suffix)
+        {
+            std::vector<Data> vec;
+            for (int i = 0; i < count; ++i)
+                vec.push_back(create_data_set(size));
+            return vec;
+        };
+
+        BENCHMARK("push_back with reserve" + suffix)
+        {
+            std::vector<Data> vec;
+            vec.reserve(count);
+            for (int i = 0; i < count; ++i)
+                vec.push_back(create_data_set(size));
+            return vec;
+        };
+    }
+}
@@ -4,16 +4,19 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
 
 using namespace std::literals;
 
-Helpers::Vector create_and_fill()
+Helpers::Vector create_and_fill(const std::string& text)
 {
     using Helpers::Vector, Helpers::String;
 
     Vector vec;
 
-    String str = "very, very, very, very, very, very, very, very, very, very, very, very, very, very, very, very long text";
+    String str = text;
 
     vec.push_back(str);
 
@@ -26,9 +29,266 @@ Helpers::Vector create_and_fill()
     return vec;
 }
 
+Helpers::Vector create_and_fill()
+{
+    return create_and_fill("very, very, very, very, very, very, very, very, very, very, very, very, very, very, very, very long text");
+}
+
 TEST_CASE("move semantics motivation")
 {
     Helpers::Vector vec = create_and_fill();
 
     Helpers::String::print_stats("Total");
-}
\ No newline at end of file
+}
+
+template <typename TString>
+std::vector<TString> create_and_fill_with(const std::string& text)
+{
+    std::vector<TString> vec;
+
+    TString str = text;
+
+    vec.push_back(str);
+
+    vec.push_back(str + str);
+
+    vec.push_back("text");
+
+    vec.push_back(str);
+
+    return vec;
+}
+
+TEST_CASE("SsoString - small buffer optimization")
+{
+    using Helpers::SsoString;
+
+    static_assert(sizeof(SsoString<>) < sizeof(Helpers::String));
+
+    SsoString<>::clear_stats();
+
+    SECTION("default value is formatted in place")
+    {
+        SsoString<> str;
+        REQUIRE(str.value() == "default1");
+        REQUIRE(str.is_small());
+    }
+
+    SECTION("short values are stored inline")
+    {
+        SsoString<> str = "short text";
+        REQUIRE(str.value() == "short text");
+        REQUIRE(str.is_small());
+    }
+
+    SECTION("long values are stored on the heap")
+    {
+        const std::string text(SsoString<>::inline_capacity + 1, 'x');
+        SsoString<> str = text;
+        REQUIRE(str.value() == text);
+        REQUIRE_FALSE(str.is_small());
+    }
+
+    SECTION("inline capacity is configurable")
+    {
+        SsoString<32> str = "text that does not fit in 15 chars";
+        REQUIRE_FALSE(str.is_small());
+
+        SsoString<32> other = "text that fits in 32 chars";
+        REQUIRE(other.is_small());
+    }
+
+    SECTION("copy & concatenation")
+    {
+        SsoString<> str = "0123456789";
+        SsoString<> copy = str;
+        REQUIRE(copy.id() == str.id());
+        REQUIRE(copy.value() == str.value());
+
+        SsoString<> sum = str + copy;
+        REQUIRE(sum.value() == "01234567890123456789");
+        REQUIRE_FALSE(sum.is_small());
+
+        copy = sum;
+        REQUIRE(copy.value() == sum.value());
+        sum = str;
+        REQUIRE(sum.value() == str.value());
+        REQUIRE(sum.is_small());
+
+        REQUIRE(SsoString<>::snapshot().copy_constructed == 1);
+        REQUIRE(SsoString<>::snapshot().copy_assigned == 2);
+    }
+
+    SECTION("create_and_fill")
+    {
+        std::vector<SsoString<>> vec = create_and_fill_with<SsoString<>>("very, very long text");
+        REQUIRE(vec.size() == 4);
+        REQUIRE(vec[1].value() == "very, very long textvery, very long text");
+        REQUIRE(vec[2].value() == "text");
+    }
+}
+
+TEST_CASE("String - concatenation")
+{
+    using Helpers::String;
+
+    const String a = "String long enough to be stored on the heap (1) ";
+    const String b = "String long enough to be stored on the heap (2) ";
+    const String c = "String long enough to be stored on the heap (3) ";
+    const String d = "String long enough to be stored on the heap (4) ";
+
+    const Helpers::StringStats before = String::snapshot();
+
+    SECTION("concat of lvalues is materialized with one allocation")
+    {
+        String result = Helpers::concat(a, b, c, d);
+
+        REQUIRE(result.value() == a.value() + b.value() + c.value() + d.value());
+        REQUIRE(String::snapshot().constructed - before.constructed == 1);
+        REQUIRE(String::snapshot().allocations - before.allocations == 1);
+    }
+
+    SECTION("operator+ returns String")
+    {
+        REQUIRE((a + b).value() == a.value() + b.value());
+
+        String result = a + b + c + d;
+        REQUIRE(result.value() == a.value() + b.value() + c.value() + d.value());
+
+        String nested = (a + b) + (c + d);
+        REQUIRE(nested.value() == result.value());
+    }
+
+    SECTION("buffer of the leftmost rvalue operand is reused")
+    {
+        std::string buffer(100, 'x');
+        buffer.reserve(1'000);
+
+        String result = String{std::move(buffer)} + a + b;
+        REQUIRE(String::snapshot().allocations - before.allocations == 0);
+        REQUIRE(result.value() == std::string(100, 'x') + a.value() + b.value());
+
+        String temp = a;
+        String moved_result = Helpers::concat(std::move(temp), a, b);
+        REQUIRE(moved_result.value() == a.value() + a.value() + b.value());
+        REQUIRE(temp.value().empty());
+    }
+
+    SECTION("rvalue operand that is also a later operand is appended intact")
+    {
+        String text = a;
+        String doubled = std::move(text) + text;
+        REQUIRE(doubled.value() == a.value() + a.value());
+
+        String other = b;
+        String chained = Helpers::concat(std::move(other), c, other);
+        REQUIRE(chained.value() == b.value() + c.value() + b.value());
+    }
+}
+
+TEST_CASE("String stats - counting from many threads")
+{
+    using Helpers::String;
+
+    constexpr int thread_count = 4;
+    constexpr int strings_per_thread = 5'000;
+
+    String::clear_stats();
+
+    std::vector<std::vector<uint64_t>> ids(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&ids, t] {
+            for (int i = 0; i < strings_per_thread; ++i)
+            {
+                String str;
+                String copy = str;
+                ids[t].push_back(copy.id());
+            }
+        });
+    }
+
+    for (auto& thd : threads)
+        thd.join();
+
+    const Helpers::StringStats stats = String::snapshot();
+    REQUIRE(stats.constructed == thread_count * strings_per_thread);
+    REQUIRE(stats.copy_constructed == thread_count * strings_per_thread);
+
+    std::set<uint64_t> unique_ids;
+    for (const auto& thread_ids : ids)
+        unique_ids.insert(thread_ids.begin(), thread_ids.end());
+    REQUIRE(unique_ids.size() == thread_count * strings_per_thread);
+
+    String::clear_stats();
+    REQUIRE(String::snapshot().constructed == 0);
+    REQUIRE(String{}.id() == 1);
+}
+
+TEST_CASE("create_and_fill", "[.][benchmark]")
+{
+    for (size_t size : {8, 128, 4 * 1'024})
+    {
+        const std::string text(size, 'x');
+
+        BENCHMARK("create_and_fill - text: " + std::to_string(size))
+        {
+            return create_and_fill(text);
+        };
+    }
+}
+
+TEST_CASE("String vs. SsoString", "[.][benchmark]")
+{
+    for (size_t size : {8, 15, 64})
+    {
+        const std::string text(size, 'x');
+        const std::string suffix = " - text: " + std::to_string(size);
+
+        BENCHMARK("create_and_fill - String" + suffix)
+        {
+            return create_and_fill_with<Helpers::String>(text);
+        };
+
+        BENCHMARK("create_and_fill - SsoString" + suffix)
+        {
+            return create_and_fill_with<Helpers::SsoString<>>(text);
+        };
+    }
+
+    BENCHMARK("default constructed - String")
+    {
+        return std::vector<Helpers::String>(1'000);
+    };
+
+    BENCHMARK("default constructed - SsoString")
+    {
+        return std::vector<Helpers::SsoString<>>(1'000);
+    };
+}
+
+TEST_CASE("String - operator+ chain", "[.][benchmark]")
+{
+    using Helpers::String;
+
+    const String a = "String long enough to be stored on the heap (1) ";
+    const String b = "String long enough to be stored on the heap (2) ";
+    const String c = "String long enough to be stored on the heap (3) ";
+    const String d = "String long enough to be stored on the heap (4) ";
+
+    BENCHMARK("eager concatenation - a + b + c + d")
+    {
+        return String{a.value() + b.value() + c.value() + d.value()};
+    };
+
+    BENCHMARK("operator+ - a + b + c + d")
+    {
+        return String{a + b + c + d};
+    };
+
+    BENCHMARK("concat(a, b, c, d)")
+    {
+        return Helpers::concat(a, b, c, d);
+    };
+}
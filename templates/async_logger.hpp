@@ -0,0 +1,316 @@
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace Logging
+{
+    ////////////////////////////////////////////////////////////////
+    // Bounded lock-free ring buffer (D. Vyukov) - every cell has a sequence number
+    // that tells producers & consumers whose turn it is; many producers, one consumer
+    // (pop is also safe from producers - used by the Overwrite policy)
+    template <typename T>
+    class MpscRingBuffer
+    {
+        struct alignas(64) Cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+        std::size_t mask_;
+        alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+        alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+
+        static std::size_t round_up_to_power_of_2(std::size_t value)
+        {
+            std::size_t result = 2;
+            while (result < value)
+                result *= 2;
+            return result;
+        }
+
+    public:
+        explicit MpscRingBuffer(std::size_t capacity)
+            : cells_{std::make_unique<Cell[]>(round_up_to_power_of_2(capacity))}
+            , mask_{round_up_to_power_of_2(capacity) - 1}
+        {
+            for (std::size_t i = 0; i <= mask_; ++i)
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return mask_ + 1;
+        }
+
+        // item is moved from only if it was pushed
+        bool try_push(T& item)
+        {
+            std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Cell& cell = cells_[pos & mask_];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(item);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool try_pop(T& item)
+        {
+            std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Cell& cell = cells_[pos & mask_];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        item = std::move(cell.value);
+                        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // empty
+                }
+                else
+                {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // OverflowPolicy - producer waits for a free slot
+    //
+    struct Block
+    {
+        template <typename TQueue, typename T>
+        static bool push(TQueue& queue, T& item, std::size_t& /*discarded*/)
+        {
+            while (!queue.try_push(item))
+                std::this_thread::yield();
+
+            return true;
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // OverflowPolicy - a new message is dropped if the queue is full
+    //
+    struct Drop
+    {
+        template <typename TQueue, typename T>
+        static bool push(TQueue& queue, T& item, std::size_t& /*discarded*/)
+        {
+            return queue.try_push(item);
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // OverflowPolicy - the oldest messages are discarded to make room for a new one
+    //
+    struct Overwrite
+    {
+        template <typename TQueue, typename T>
+        static bool push(TQueue& queue, T& item, std::size_t& discarded)
+        {
+            T oldest;
+            while (!queue.try_push(item))
+            {
+                if (queue.try_pop(oldest))
+                    ++discarded;
+            }
+
+            return true;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////
+    // log() only enqueues a message - a background thread formats messages
+    // & writes them in batches (one flush per batch instead of std::endl per line)
+    template <typename TFormatter, typename OverflowPolicy = Block>
+    class AsyncLogger
+    {
+        static constexpr std::size_t max_batch_size = 256;
+
+        TFormatter formatter_;
+        std::ostream& out_;
+        MpscRingBuffer<std::string> queue_;
+
+        alignas(64) std::atomic<std::uint64_t> enqueued_{0};
+        alignas(64) std::atomic<std::uint64_t> processed_{0}; // written or discarded
+        std::atomic<std::uint64_t> lost_{0};
+
+        std::atomic<bool> consumer_waiting_{false};
+        std::atomic<std::uint32_t> wake_signal_{0};
+        std::atomic<bool> stop_{false};
+
+        std::jthread consumer_; // started last
+
+        void wake_consumer()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the fence in wait_for_messages()
+
+            if (consumer_waiting_.load(std::memory_order_relaxed))
+            {
+                wake_signal_.fetch_add(1, std::memory_order_release);
+                wake_signal_.notify_one();
+            }
+        }
+
+        // returns true if a message was popped
+        bool wait_for_messages(std::string& message)
+        {
+            const std::uint32_t signal = wake_signal_.load(std::memory_order_acquire);
+            consumer_waiting_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // re-checked after announcing the wait - a producer either sees the flag or its message is seen here
+            const bool popped = queue_.try_pop(message);
+            if (!popped && !stop_.load(std::memory_order_acquire))
+                wake_signal_.wait(signal, std::memory_order_acquire);
+
+            consumer_waiting_.store(false, std::memory_order_relaxed);
+            return popped;
+        }
+
+        void consume()
+        {
+            std::string message;
+            std::string batch;
+
+            while (true)
+            {
+                if (!queue_.try_pop(message))
+                {
+                    if (stop_.load(std::memory_order_acquire))
+                    {
+                        if (!queue_.try_pop(message)) // messages pushed before stop are visible now
+                            break;
+                    }
+                    else if (!wait_for_messages(message))
+                    {
+                        continue;
+                    }
+                }
+
+                std::size_t count = 0;
+                do
+                {
+                    if constexpr (requires { formatter_.format_in_place(message); })
+                    {
+                        formatter_.format_in_place(message); // message is owned by the consumer - no copy
+                        batch += message;
+                    }
+                    else
+                    {
+                        batch += formatter_.format(message);
+                    }
+                    batch += '\n';
+                    ++count;
+                } while (count < max_batch_size && queue_.try_pop(message));
+
+                out_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                out_.flush();
+                batch.clear();
+
+                processed_.fetch_add(count, std::memory_order_release);
+            }
+        }
+
+    public:
+        static constexpr std::size_t default_capacity = 4096;
+
+        explicit AsyncLogger(std::ostream& out = std::cout, std::size_t capacity = default_capacity, TFormatter formatter = TFormatter{})
+            : formatter_(std::move(formatter))
+            , out_{out}
+            , queue_{capacity}
+            , consumer_{[this] { consume(); }}
+        {
+        }
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // pending messages are written before the consumer stops
+        ~AsyncLogger()
+        {
+            stop_.store(true, std::memory_order_release);
+            wake_consumer();
+        }
+
+        void log(std::string message)
+        {
+            // counted before the push - processed_ never runs ahead of enqueued_,
+            // so flush() cannot miss a message that is already in the queue
+            enqueued_.fetch_add(1, std::memory_order_relaxed);
+
+            std::size_t discarded = 0;
+            const bool pushed = OverflowPolicy::push(queue_, message, discarded);
+
+            // a dropped message is processed at once
+            if (const std::size_t lost = discarded + (pushed ? 0 : 1); lost != 0)
+            {
+                processed_.fetch_add(lost, std::memory_order_relaxed);
+                lost_.fetch_add(lost, std::memory_order_relaxed);
+            }
+
+            wake_consumer();
+        }
+
+        // waits until all messages logged before the call are written (or discarded)
+        void flush()
+        {
+            const std::uint64_t target = enqueued_.load();
+
+            while (processed_.load(std::memory_order_acquire) < target)
+            {
+                wake_consumer();
+                std::this_thread::yield();
+            }
+        }
+
+        // messages dropped or overwritten because the queue was full
+        std::uint64_t lost() const noexcept
+        {
+            return lost_.load(std::memory_order_relaxed);
+        }
+    };
+} // namespace Logging
+
+#endif
@@ -0,0 +1,421 @@
+#ifndef LOCK_FREE_STACK_HPP
+#define LOCK_FREE_STACK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Concurrent
+{
+    namespace Detail
+    {
+        inline constexpr std::size_t cache_line_size = 64;
+        inline constexpr std::size_t max_hazard_pointers = 256;
+
+        ////////////////////////////////////////////////////////////////
+        // Hazard pointers - a node published in a hazard pointer is not deleted
+        // until the owning thread clears it
+        struct alignas(cache_line_size) HazardPointer
+        {
+            std::atomic<bool> in_use{false};
+            std::atomic<void*> pointer{nullptr};
+        };
+
+        inline HazardPointer hazard_pointers[max_hazard_pointers];
+
+        class HazardOwner
+        {
+            HazardPointer* hp_{};
+
+        public:
+            HazardOwner()
+            {
+                for (HazardPointer& hp : hazard_pointers)
+                {
+                    bool expected = false;
+                    if (!hp.in_use.load(std::memory_order_relaxed) && hp.in_use.compare_exchange_strong(expected, true))
+                    {
+                        hp_ = &hp;
+                        return;
+                    }
+                }
+
+                throw std::runtime_error("No hazard pointers available");
+            }
+
+            HazardOwner(const HazardOwner&) = delete;
+            HazardOwner& operator=(const HazardOwner&) = delete;
+
+            ~HazardOwner()
+            {
+                hp_->pointer.store(nullptr);
+                hp_->in_use.store(false, std::memory_order_release);
+            }
+
+            std::atomic<void*>& pointer() noexcept
+            {
+                return hp_->pointer;
+            }
+        };
+
+        // every thread owns one hazard pointer - pop() protects a single node at a time
+        inline std::atomic<void*>& hazard_pointer_for_current_thread()
+        {
+            thread_local HazardOwner owner;
+            return owner.pointer();
+        }
+
+        inline std::vector<void*> collect_hazards()
+        {
+            std::vector<void*> hazards;
+            for (const HazardPointer& hp : hazard_pointers)
+            {
+                if (void* pointer = hp.pointer.load())
+                    hazards.push_back(pointer);
+            }
+
+            std::sort(hazards.begin(), hazards.end());
+            return hazards;
+        }
+
+        struct RetiredNode
+        {
+            void* pointer;
+            void (*deleter)(void*);
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // nodes left by threads that finished while the nodes were still protected
+        class OrphanedNodes
+        {
+            std::mutex mtx_;
+            std::vector<RetiredNode> nodes_;
+
+        public:
+            static OrphanedNodes& instance()
+            {
+                static OrphanedNodes orphans;
+                return orphans;
+            }
+
+            ~OrphanedNodes()
+            {
+                for (const RetiredNode& node : nodes_)
+                    node.deleter(node.pointer);
+            }
+
+            void adopt(std::vector<RetiredNode>& nodes)
+            {
+                std::lock_guard lk{mtx_};
+                nodes_.insert(nodes_.end(), nodes.begin(), nodes.end());
+                nodes.clear();
+            }
+
+            void take(std::vector<RetiredNode>& nodes)
+            {
+                std::lock_guard lk{mtx_};
+                nodes.insert(nodes.end(), nodes_.begin(), nodes_.end());
+                nodes_.clear();
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // nodes removed by the current thread - deleted in batches when no hazard pointer
+        // refers to them; the scan is amortized over at least scan_threshold retirements
+        class RetiredList
+        {
+            std::vector<RetiredNode> nodes_;
+            std::size_t next_scan_ = scan_threshold;
+
+        public:
+            static constexpr std::size_t scan_threshold = 2 * max_hazard_pointers;
+
+            RetiredList()
+            {
+                OrphanedNodes::instance(); // outlives thread_local lists of the main thread
+            }
+
+            RetiredList(const RetiredList&) = delete;
+            RetiredList& operator=(const RetiredList&) = delete;
+
+            ~RetiredList()
+            {
+                reclaim();
+
+                if (!nodes_.empty())
+                    OrphanedNodes::instance().adopt(nodes_);
+            }
+
+            void retire(RetiredNode node)
+            {
+                nodes_.push_back(node);
+
+                if (nodes_.size() >= next_scan_)
+                    reclaim();
+            }
+
+            void reclaim()
+            {
+                OrphanedNodes::instance().take(nodes_);
+
+                const std::vector<void*> hazards = collect_hazards();
+                auto unprotected = std::partition(nodes_.begin(), nodes_.end(), [&hazards](const RetiredNode& node) {
+                    return std::binary_search(hazards.begin(), hazards.end(), node.pointer);
+                });
+
+                for (auto it = unprotected; it != nodes_.end(); ++it)
+                    it->deleter(it->pointer);
+                nodes_.erase(unprotected, nodes_.end());
+
+                next_scan_ = std::max(scan_threshold, 2 * nodes_.size());
+            }
+        };
+
+        inline RetiredList& retired_list()
+        {
+            thread_local RetiredList list;
+            return list;
+        }
+
+        template <typename TNode>
+        void retire(TNode* node)
+        {
+            retired_list().retire(RetiredNode{node, [](void* pointer) { delete static_cast<TNode*>(pointer); }});
+        }
+    } // namespace Detail
+
+    // deletes nodes retired by the calling thread (and orphaned by finished threads)
+    // that are no longer protected by any hazard pointer
+    inline void reclaim_retired()
+    {
+        Detail::retired_list().reclaim();
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // BackoffPolicy - CAS on the head failed
+    //
+    class NoBackoff
+    {
+    protected:
+        ~NoBackoff() = default;
+
+        template <typename TNode>
+        bool exchange_push(TNode*) noexcept
+        {
+            return false;
+        }
+
+        template <typename TNode>
+        TNode* exchange_pop() noexcept
+        {
+            return nullptr;
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // BackoffPolicy - push & pop that meet in a slot of an elimination array
+    // cancel each other out without touching the head of the stack
+    //
+    template <std::size_t SlotCount = 16, std::size_t SpinCount = 256>
+    class EliminationBackoff
+    {
+        struct alignas(Detail::cache_line_size) Slot
+        {
+            std::atomic<void*> node{nullptr};
+        };
+
+        Slot slots_[SlotCount];
+
+        // marks a slot whose node was taken by pop
+        static void* taken() noexcept
+        {
+            static char marker;
+            return &marker;
+        }
+
+        Slot& random_slot() noexcept
+        {
+            thread_local std::uint32_t state = static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            return slots_[state % SlotCount];
+        }
+
+    protected:
+        ~EliminationBackoff() = default;
+
+        // offers a node in a slot & waits for a pop to take it; withdraws the offer on timeout
+        template <typename TNode>
+        bool exchange_push(TNode* node) noexcept
+        {
+            Slot& slot = random_slot();
+
+            void* expected = nullptr;
+            if (!slot.node.compare_exchange_strong(expected, node, std::memory_order_acq_rel))
+                return false;
+
+            for (std::size_t i = 0; i < SpinCount; ++i)
+            {
+                if (slot.node.load(std::memory_order_acquire) == taken())
+                {
+                    slot.node.store(nullptr, std::memory_order_release);
+                    return true;
+                }
+            }
+
+            expected = node;
+            if (slot.node.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+                return false;
+
+            slot.node.store(nullptr, std::memory_order_release); // taken in the meantime
+            return true;
+        }
+
+        // takes a node offered by a concurrent push - it was never visible on the stack
+        template <typename TNode>
+        TNode* exchange_pop() noexcept
+        {
+            Slot& slot = random_slot();
+
+            void* node = slot.node.load(std::memory_order_acquire);
+            if (node == nullptr || node == taken())
+                return nullptr;
+
+            if (!slot.node.compare_exchange_strong(node, taken(), std::memory_order_acq_rel))
+                return nullptr;
+
+            return static_cast<TNode*>(node);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////
+    // Treiber stack - removed nodes are reclaimed with hazard pointers
+    //
+    // top() is not provided - a reference to the top item would be invalidated by
+    // a concurrent pop; pop(item) moves the item out instead
+    template <typename T, typename BackoffPolicy = NoBackoff>
+    class LockFreeStack : private BackoffPolicy
+    {
+        struct Node
+        {
+            T data;
+            Node* next{};
+
+            template <typename... TArgs>
+            explicit Node(TArgs&&... args)
+                : data(std::forward<TArgs>(args)...)
+            {
+            }
+        };
+
+        alignas(Detail::cache_line_size) std::atomic<Node*> head_{nullptr};
+
+    public:
+        LockFreeStack() = default;
+
+        LockFreeStack(const LockFreeStack&) = delete;
+        LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+        ~LockFreeStack()
+        {
+            Node* node = head_.load(std::memory_order_relaxed);
+            while (node)
+            {
+                delete std::exchange(node, node->next);
+            }
+        }
+
+        template <typename TValue>
+        void push(TValue&& value)
+        {
+            emplace(std::forward<TValue>(value));
+        }
+
+        template <typename... TArgs>
+        void emplace(TArgs&&... args)
+        {
+            Node* node = new Node(std::forward<TArgs>(args)...);
+
+            node->next = head_.load(std::memory_order_relaxed);
+            while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+            {
+                if (BackoffPolicy::exchange_push(node))
+                    return;
+            }
+        }
+
+        // moves the top item to item; returns false if the stack is empty
+        bool pop(T& item)
+        {
+            std::atomic<void*>& hazard = Detail::hazard_pointer_for_current_thread();
+
+            Node* node = head_.load();
+            while (true)
+            {
+                // node can be dereferenced only if it was still the head after it had been protected
+                Node* protected_node;
+                do
+                {
+                    protected_node = node;
+                    hazard.store(node);
+                    node = head_.load();
+                } while (node != protected_node);
+
+                if (node == nullptr)
+                {
+                    hazard.store(nullptr, std::memory_order_release);
+                    return false;
+                }
+
+                if (head_.compare_exchange_strong(node, node->next, std::memory_order_acquire))
+                    break;
+
+                if (Node* eliminated = BackoffPolicy::template exchange_pop<Node>())
+                {
+                    hazard.store(nullptr, std::memory_order_release);
+
+                    std::unique_ptr<Node> owner{eliminated};
+                    item = std::move(owner->data);
+                    return true;
+                }
+            }
+
+            hazard.store(nullptr, std::memory_order_release);
+
+            // other threads may still read node->next - node is only retired
+            struct RetireGuard
+            {
+                Node* node;
+
+                ~RetireGuard()
+                {
+                    Detail::retire(node);
+                }
+            } guard{node};
+
+            item = std::move(node->data);
+            return true;
+        }
+
+        bool empty() const noexcept
+        {
+            return head_.load(std::memory_order_acquire) == nullptr;
+        }
+    };
+
+    template <typename T>
+    using EliminationBackoffStack = LockFreeStack<T, EliminationBackoff<>>;
+} // namespace Concurrent
+
+#endif
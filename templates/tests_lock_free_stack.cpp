@@ -0,0 +1,256 @@
+#include "lock_free_stack.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    struct Tracked
+    {
+        static inline std::atomic<int> alive{0};
+
+        int value;
+
+        Tracked(int value = 0)
+            : value{value}
+        {
+            ++alive;
+        }
+
+        Tracked(const Tracked& other)
+            : value{other.value}
+        {
+            ++alive;
+        }
+
+        Tracked& operator=(const Tracked&) = default;
+
+        ~Tracked()
+        {
+            --alive;
+        }
+    };
+
+    // producers push values [0; producers * items_per_producer); consumers pop until all of them are taken
+    template <typename TStack>
+    std::vector<int> push_pop_concurrently(TStack& stack, int producers, int consumers, int items_per_producer)
+    {
+        const int total = producers * items_per_producer;
+        std::atomic<int> popped_count{0};
+        std::vector<std::vector<int>> popped(consumers);
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (int p = 0; p < producers; ++p)
+            {
+                threads.emplace_back([&stack, p, items_per_producer] {
+                    for (int i = 0; i < items_per_producer; ++i)
+                        stack.push(p * items_per_producer + i);
+                });
+            }
+
+            for (int c = 0; c < consumers; ++c)
+            {
+                threads.emplace_back([&, c] {
+                    int item;
+                    while (popped_count.load() < total)
+                    {
+                        if (stack.pop(item))
+                        {
+                            popped[c].push_back(item);
+                            ++popped_count;
+                        }
+                    }
+                });
+            }
+        }
+
+        std::vector<int> all;
+        for (const auto& items : popped)
+            all.insert(all.end(), items.begin(), items.end());
+        std::sort(all.begin(), all.end());
+
+        return all;
+    }
+} // namespace
+
+TEST_CASE("LockFreeStack - single thread")
+{
+    Concurrent::LockFreeStack<int> s;
+
+    int item = -1;
+
+    SECTION("is empty after construction")
+    {
+        REQUIRE(s.empty());
+        REQUIRE_FALSE(s.pop(item));
+        REQUIRE(item == -1);
+    }
+
+    SECTION("LIFO order")
+    {
+        s.push(1);
+        s.emplace(4);
+        REQUIRE_FALSE(s.empty());
+
+        REQUIRE(s.pop(item));
+        REQUIRE(item == 4);
+        REQUIRE(s.pop(item));
+        REQUIRE(item == 1);
+        REQUIRE(s.empty());
+    }
+}
+
+TEST_CASE("LockFreeStack - move-only items")
+{
+    Concurrent::EliminationBackoffStack<std::unique_ptr<std::string>> s;
+
+    s.push(std::make_unique<std::string>("test1"));
+    s.emplace(new std::string("test2"));
+
+    std::unique_ptr<std::string> value;
+
+    REQUIRE(s.pop(value));
+    REQUIRE(*value == "test2"s);
+    REQUIRE(s.pop(value));
+    REQUIRE(*value == "test1"s);
+}
+
+TEST_CASE("LockFreeStack - many producers & consumers")
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int items_per_producer = 10'000;
+
+    std::vector<int> expected(producers * items_per_producer);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    SECTION("Treiber stack")
+    {
+        Concurrent::LockFreeStack<int> s;
+
+        REQUIRE(push_pop_concurrently(s, producers, consumers, items_per_producer) == expected);
+        REQUIRE(s.empty());
+    }
+
+    SECTION("elimination backoff")
+    {
+        Concurrent::EliminationBackoffStack<int> s;
+
+        REQUIRE(push_pop_concurrently(s, producers, consumers, items_per_producer) == expected);
+        REQUIRE(s.empty());
+    }
+}
+
+TEST_CASE("LockFreeStack - retired nodes are reclaimed")
+{
+    {
+        Concurrent::LockFreeStack<Tracked> s;
+
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&s] {
+                Tracked item;
+                for (int i = 0; i < 1'000; ++i)
+                {
+                    s.push(Tracked{i});
+                    s.pop(item);
+                }
+            });
+        }
+        threads.clear(); // joins
+
+        s.push(Tracked{42}); // destroyed with the stack
+    }
+
+    Concurrent::reclaim_retired();
+
+    REQUIRE(Tracked::alive == 0);
+}
+
+namespace
+{
+    // baseline - the same interface guarded by a mutex
+    template <typename T>
+    class LockedStack
+    {
+        std::vector<T> items_;
+        std::mutex mtx_;
+
+    public:
+        template <typename TValue>
+        void push(TValue&& value)
+        {
+            std::lock_guard lk{mtx_};
+            items_.push_back(std::forward<TValue>(value));
+        }
+
+        bool pop(T& item)
+        {
+            std::lock_guard lk{mtx_};
+
+            if (items_.empty())
+                return false;
+
+            item = std::move(items_.back());
+            items_.pop_back();
+            return true;
+        }
+    };
+
+    template <typename TStack>
+    void run_push_pop(unsigned thread_count, int operations_per_thread)
+    {
+        TStack stack;
+
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&stack, operations_per_thread] {
+                int item;
+                for (int i = 0; i < operations_per_thread; ++i)
+                {
+                    stack.push(i);
+                    stack.pop(item);
+                }
+            });
+        }
+    }
+} // namespace
+
+TEST_CASE("Concurrent stacks - contention", "[.][benchmark]")
+{
+    constexpr int operations_per_thread = 10'000;
+
+    for (unsigned thread_count : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+    {
+        const std::string suffix = " - threads: " + std::to_string(thread_count);
+
+        BENCHMARK("std::mutex" + suffix)
+        {
+            run_push_pop<LockedStack<int>>(thread_count, operations_per_thread);
+        };
+
+        BENCHMARK("Treiber stack" + suffix)
+        {
+            run_push_pop<Concurrent::LockFreeStack<int>>(thread_count, operations_per_thread);
+        };
+
+        BENCHMARK("elimination backoff" + suffix)
+        {
+            run_push_pop<Concurrent::EliminationBackoffStack<int>>(thread_count, operations_per_thread);
+        };
+    }
+}
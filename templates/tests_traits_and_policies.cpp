@@ -1,17 +1,101 @@
+#include "allocation_counter.hpp"
+#include "async_logger.hpp"
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <future>
 #include <mutex>
+#include <numeric>
+#include <ranges>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+constexpr char to_upper_ascii(char c) noexcept
+{
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+}
+
+////////////////////////////////////////////////////////////////
+// ASCII uppercase - 8 chars per step (SWAR); other bytes are left unchanged
+inline void to_upper_ascii(char* text, std::size_t size) noexcept
+{
+    constexpr std::uint64_t ones = 0x0101010101010101;
+    constexpr std::uint64_t high_bits = 0x80 * ones;
+
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, text + i, sizeof(word));
+
+        // a high bit of each byte is set for: heptet >= 'a', heptet > 'z'; no carries between bytes
+        const std::uint64_t heptets = word & ~high_bits;
+        const std::uint64_t at_least_a = heptets + (0x80 - 'a') * ones;
+        const std::uint64_t above_z = heptets + (0x7F - 'z') * ones;
+        const std::uint64_t is_lower = at_least_a & ~above_z & ~word & high_bits;
+
+        word ^= is_lower >> 2; // 0x80 >> 2 == 'a' - 'A'
+        std::memcpy(text + i, &word, sizeof(word));
+    }
+
+    for (; i < size; ++i)
+        text[i] = to_upper_ascii(text[i]);
+}
+
+// formatter writes a message to a caller-provided buffer - capacity of the buffer is reused
+template <typename TFormatter>
+concept BufferFormatter = requires(const TFormatter& formatter, std::string_view message, std::string& buffer) {
+    formatter.format_to(message, buffer);
+};
+
+// formatter transforms a message in place - no allocation for an rvalue string
+template <typename TFormatter>
+concept InPlaceFormatter = requires(const TFormatter& formatter, std::string& message) {
+    formatter.format_in_place(message);
+};
 
 struct UpperCaseFormatter
 {
     std::string format(const std::string& message) const
     {
         std::string result = message;
-        std::transform(result.begin(), result.end(), 
-                       result.begin(), [](char c) { return std::toupper(c); });   
+        format_in_place(result);
         return result;
     }
+
+    void format_to(std::string_view message, std::string& buffer) const
+    {
+        buffer.assign(message);
+        format_in_place(buffer);
+    }
+
+    void format_in_place(std::string& message) const noexcept
+    {
+        to_upper_ascii(message.data(), message.size());
+    }
+
+    void map(char* text, std::size_t size, std::size_t /*position*/) const noexcept
+    {
+        to_upper_ascii(text, size);
+    }
 };
 
 struct CapitalizeFormatter
@@ -19,15 +103,216 @@ struct CapitalizeFormatter
     std::string format(const std::string& message) const
     {
         std::string result = message;
-        result[0] = std::toupper(result[0]);
+        format_in_place(result);
+        return result;
+    }
+
+    void format_to(std::string_view message, std::string& buffer) const
+    {
+        buffer.assign(message);
+        format_in_place(buffer);
+    }
+
+    void format_in_place(std::string& message) const noexcept
+    {
+        map(message.data(), message.size(), 0);
+    }
+
+    void map(char* text, std::size_t size, std::size_t position) const noexcept
+    {
+        if (position == 0 && size != 0)
+            text[0] = to_upper_ascii(text[0]);
+    }
+};
+
+// prefixes a message with a time of day: "[hh:mm:ss.mmm] "
+template <typename TClock = std::chrono::system_clock>
+struct TimestampFormatter
+{
+    static constexpr std::size_t prefix_size = 15;
+
+    void write_prefix(char* out) const noexcept
+    {
+        using namespace std::chrono;
+
+        constexpr auto ms_per_day = duration_cast<milliseconds>(days{1}).count();
+        const auto ms = duration_cast<milliseconds>(TClock::now().time_since_epoch()).count() % ms_per_day;
+
+        const auto write_2_digits = [](char* out, auto value) {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+        };
+
+        out[0] = '[';
+        write_2_digits(out + 1, ms / 3'600'000);
+        out[3] = ':';
+        write_2_digits(out + 4, ms / 60'000 % 60);
+        out[6] = ':';
+        write_2_digits(out + 7, ms / 1000 % 60);
+        out[9] = '.';
+        out[10] = static_cast<char>('0' + ms % 1000 / 100);
+        write_2_digits(out + 11, ms % 100);
+        out[13] = ']';
+        out[14] = ' ';
+    }
+
+    std::string format(const std::string& message) const
+    {
+        std::string result;
+        format_to(message, result);
         return result;
     }
+
+    void format_to(std::string_view message, std::string& buffer) const
+    {
+        buffer.resize(prefix_size + message.size());
+        write_prefix(buffer.data());
+        std::ranges::copy(message, buffer.data() + prefix_size);
+    }
+
+    void format_in_place(std::string& message) const
+    {
+        message.insert(0, prefix_size, ' ');
+        write_prefix(message.data());
+    }
+};
+
+// stage of FormatterChain - transforms chars in place; position - index of the first char in the output of the stage
+template <typename TFormatter>
+concept CharMapFormatter = requires(const TFormatter& formatter, char* text, std::size_t size, std::size_t position) {
+    formatter.map(text, size, position);
+};
+
+// stage of FormatterChain - adds a prefix of fixed size
+template <typename TFormatter>
+concept PrefixFormatter = requires(const TFormatter& formatter, char* out) {
+    { TFormatter::prefix_size } -> std::convertible_to<std::size_t>;
+    formatter.write_prefix(out);
+};
+
+////////////////////////////////////////////////////////////////
+// formatters applied left to right in a single pass over the text - no intermediate strings
+//
+// prefixes of later stages are written in front of the text; a char map of a stage
+// is applied to the message & to prefixes of the earlier stages - offsets are known at compile time;
+// the message is copied & mapped by all stages in chunks that stay in L1 cache
+template <typename... TFormatters>
+    requires((CharMapFormatter<TFormatters> || PrefixFormatter<TFormatters>) && ...)
+class FormatterChain
+{
+    using Stages = std::tuple<TFormatters...>;
+
+    Stages formatters_;
+
+    template <typename TFormatter>
+    static constexpr std::size_t prefix_size_of()
+    {
+        if constexpr (PrefixFormatter<TFormatter>)
+            return TFormatter::prefix_size;
+        else
+            return 0;
+    }
+
+    static constexpr std::array<std::size_t, sizeof...(TFormatters)> prefix_sizes{prefix_size_of<TFormatters>()...};
+
+    // where the output of a stage starts in the final text
+    static constexpr std::size_t offset_of(std::size_t stage)
+    {
+        std::size_t offset = 0;
+        for (std::size_t i = stage + 1; i < prefix_sizes.size(); ++i)
+            offset += prefix_sizes[i];
+        return offset;
+    }
+
+public:
+    static constexpr std::size_t total_prefix_size = (prefix_size_of<TFormatters>() + ... + 0);
+
+    FormatterChain() = default;
+
+    explicit FormatterChain(TFormatters... formatters) requires(sizeof...(TFormatters) > 0)
+        : formatters_(std::move(formatters)...)
+    {
+    }
+
+    std::string format(const std::string& message) const
+    {
+        std::string result;
+        format_to(message, result);
+        return result;
+    }
+
+    void format_to(std::string_view message, std::string& buffer) const
+    {
+        buffer.resize(total_prefix_size + message.size());
+        run(message.data(), message.size(), buffer.data());
+    }
+
+    void format_in_place(std::string& message) const
+    {
+        message.insert(0, total_prefix_size, ' ');
+        run(message.data() + total_prefix_size, message.size() - total_prefix_size, message.data());
+    }
+
+private:
+    static constexpr std::size_t chunk_size = 1024;
+
+    // out has room for prefixes & message; message may already be in place (message == out + total_prefix_size)
+    void run(const char* message, std::size_t size, char* out) const
+    {
+        [&]<std::size_t... Stage>(std::index_sequence<Stage...>) {
+            (write_prefix<Stage>(out), ...);
+            (map_prefixes<Stage>(out), ...);
+        }(std::index_sequence_for<TFormatters...>{});
+
+        char* text = out + total_prefix_size;
+        for (std::size_t first = 0; first < size; first += chunk_size)
+        {
+            const std::size_t count = std::min(chunk_size, size - first);
+
+            if (message != text)
+                std::copy_n(message + first, count, text + first); // memcpy of a bounded size is inlined as slow 'rep movs' by gcc
+
+            [&]<std::size_t... Stage>(std::index_sequence<Stage...>) {
+                (map_chunk<Stage>(text + first, count, total_prefix_size + first), ...);
+            }(std::index_sequence_for<TFormatters...>{});
+        }
+    }
+
+    template <std::size_t Stage>
+    void write_prefix(char* out) const
+    {
+        if constexpr (PrefixFormatter<std::tuple_element_t<Stage, Stages>>)
+            std::get<Stage>(formatters_).write_prefix(out + offset_of(Stage));
+    }
+
+    template <std::size_t Stage>
+    void map_prefixes(char* out) const
+    {
+        constexpr std::size_t offset = offset_of(Stage);
+
+        if constexpr (CharMapFormatter<std::tuple_element_t<Stage, Stages>> && offset < total_prefix_size)
+            std::get<Stage>(formatters_).map(out + offset, total_prefix_size - offset, 0);
+    }
+
+    // position - index of the chunk in the final text
+    template <std::size_t Stage>
+    void map_chunk(char* chunk, std::size_t count, std::size_t position) const
+    {
+        if constexpr (CharMapFormatter<std::tuple_element_t<Stage, Stages>>)
+            std::get<Stage>(formatters_).map(chunk, count, position - offset_of(Stage));
+    }
 };
 
 template <typename TFormatter = UpperCaseFormatter>
 class Logger 
 {
     TFormatter formatter_;
+
+    static void write(std::string_view text)
+    {
+        std::cout << text << std::endl;
+    }
+
 public:   
     Logger() = default;
 
@@ -36,134 +321,1085 @@ public:
     {
     }
 
-    void log(const std::string& message)
-    {        
-        std::cout << formatter_.format(message) << std::endl;
+    void log(std::string_view message)
+    {
+        if constexpr (BufferFormatter<TFormatter>)
+        {
+            thread_local std::string buffer; // keeps its capacity between calls
+            formatter_.format_to(message, buffer);
+            write(buffer);
+        }
+        else
+        {
+            write(formatter_.format(std::string(message)));
+        }
+    }
+
+    void log(const char* message)
+    {
+        log(std::string_view{message});
+    }
+
+    void log(std::string&& message)
+    {
+        if constexpr (InPlaceFormatter<TFormatter>)
+        {
+            formatter_.format_in_place(message);
+            write(message);
+        }
+        else
+        {
+            log(std::string_view{message});
+        }
+    }
+};
+
+TEST_CASE("static polymorphism")
+{   
+    Logger<CapitalizeFormatter> logger_1;
+    logger_1.log("hello");
+
+    Logger<> logger_2;
+    logger_2.log("world");
+
+    Logger logger_3{CapitalizeFormatter{}};
+    logger_3.log("ctad");
+}
+
+namespace
+{
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        std::streamsize xsputn(const char*, std::streamsize n) override
+        {
+            return n;
+        }
+
+        int_type overflow(int_type ch) override
+        {
+            return ch;
+        }
+    };
+
+    // redirects std::cout for the lifetime of the object
+    class CoutRedirect
+    {
+        std::streambuf* original_;
+
+    public:
+        explicit CoutRedirect(std::streambuf* buffer)
+            : original_{std::cout.rdbuf(buffer)}
+        {
+        }
+
+        CoutRedirect(const CoutRedirect&) = delete;
+        CoutRedirect& operator=(const CoutRedirect&) = delete;
+
+        ~CoutRedirect()
+        {
+            std::cout.rdbuf(original_);
+        }
+    };
+} // namespace
+
+TEST_CASE("allocation-free formatters")
+{
+    static_assert(BufferFormatter<UpperCaseFormatter> && InPlaceFormatter<UpperCaseFormatter>);
+    static_assert(BufferFormatter<CapitalizeFormatter> && InPlaceFormatter<CapitalizeFormatter>);
+
+    SECTION("ASCII uppercase kernel")
+    {
+        std::string all_chars;
+        for (int c = 0; c < 256; ++c)
+            all_chars += static_cast<char>(c);
+
+        // every offset & length - a word step and a scalar tail
+        for (std::size_t offset = 0; offset < 8; ++offset)
+        {
+            std::string text = all_chars.substr(offset) + "mixed Case text: abc xyz @[`{";
+            std::string expected = text;
+            std::transform(expected.begin(), expected.end(), expected.begin(), [](char c) {
+                return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+            });
+
+            to_upper_ascii(text.data(), text.size());
+            REQUIRE(text == expected);
+        }
+    }
+
+    SECTION("format_to reuses capacity of a buffer")
+    {
+        UpperCaseFormatter formatter;
+        std::string buffer;
+        buffer.reserve(64);
+
+        const auto allocations_before = Helpers::AllocationCounter::allocations;
+        formatter.format_to("a log message longer than small string buffer", buffer);
+        REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+
+        REQUIRE(buffer == "A LOG MESSAGE LONGER THAN SMALL STRING BUFFER");
+    }
+
+    SECTION("format_in_place")
+    {
+        std::string message = "a log message longer than small string buffer";
+
+        const auto allocations_before = Helpers::AllocationCounter::allocations;
+        CapitalizeFormatter{}.format_in_place(message);
+        REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+
+        REQUIRE(message == "A log message longer than small string buffer");
+    }
+
+    SECTION("empty message")
+    {
+        std::string message;
+        CapitalizeFormatter{}.format_in_place(message);
+        REQUIRE(message.empty());
+    }
+
+    SECTION("Logger")
+    {
+        SECTION("output")
+        {
+            std::ostringstream out;
+            CoutRedirect redirect{out.rdbuf()};
+
+            Logger<> logger;
+            std::string message = "rvalue";
+            logger.log("string_view");
+            logger.log(std::move(message));
+
+            REQUIRE(out.str() == "STRING_VIEW\nRVALUE\n");
+        }
+
+        SECTION("no allocations")
+        {
+            NullBuffer null_buffer;
+            CoutRedirect redirect{&null_buffer};
+
+            Logger<> logger;
+            const std::string_view message = "a log message longer than small string buffer";
+            logger.log(message); // warms up the thread_local buffer
+
+            std::string rvalue_message{message};
+
+            const auto allocations_before = Helpers::AllocationCounter::allocations;
+            logger.log(message);
+            logger.log(std::move(rvalue_message));
+            REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+        }
+    }
+}
+
+TEST_CASE("allocation-free formatters - uppercase", "[.][benchmark]")
+{
+    UpperCaseFormatter formatter;
+
+    for (std::size_t size : {16u, 64u, 256u, 1024u, 4096u})
+    {
+        const std::string message(size, 'x');
+        const std::string suffix = " - size: " + std::to_string(size);
+
+        BENCHMARK("format() - copy" + suffix)
+        {
+            return formatter.format(message);
+        };
+
+        BENCHMARK_ADVANCED("format_to() - reused buffer" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::string buffer;
+            meter.measure([&] {
+                formatter.format_to(message, buffer);
+                return buffer.size();
+            });
+        };
+
+        BENCHMARK("std::toupper - per char" + suffix)
+        {
+            std::string result = message;
+            std::transform(result.begin(), result.end(), result.begin(), [](char c) { return std::toupper(c); });
+            return result;
+        };
+    }
+}
+
+namespace
+{
+    // 13:05:09.042 of some day
+    struct FixedClock
+    {
+        static std::chrono::sys_time<std::chrono::milliseconds> now()
+        {
+            using namespace std::chrono;
+            return sys_days{2024y / September / 25} + 13h + 5min + 9s + 42ms;
+        }
+    };
+
+    struct InfoPrefix
+    {
+        static constexpr std::size_t prefix_size = 6;
+
+        void write_prefix(char* out) const
+        {
+            std::memcpy(out, "info: ", prefix_size);
+        }
+    };
+} // namespace
+
+TEST_CASE("formatter chains")
+{
+    using Timestamp = TimestampFormatter<FixedClock>;
+
+    SECTION("timestamp")
+    {
+        REQUIRE(Timestamp{}.format("hello") == "[13:05:09.042] hello");
+    }
+
+    SECTION("stages are applied left to right")
+    {
+        REQUIRE(FormatterChain<InfoPrefix, UpperCaseFormatter>{}.format("hello") == "INFO: HELLO");
+        REQUIRE(FormatterChain<UpperCaseFormatter, InfoPrefix>{}.format("hello") == "info: HELLO");
+        REQUIRE(FormatterChain<InfoPrefix, CapitalizeFormatter>{}.format("hello") == "Info: hello");
+        REQUIRE(FormatterChain<CapitalizeFormatter, InfoPrefix>{}.format("hello") == "info: Hello");
+        REQUIRE(FormatterChain<InfoPrefix, Timestamp, CapitalizeFormatter>{}.format("hello") == "[13:05:09.042] info: hello");
+        REQUIRE(FormatterChain<>{}.format("hello") == "hello");
+    }
+
+    SECTION("result is the same as sequential application")
+    {
+        const FormatterChain<CapitalizeFormatter, Timestamp, UpperCaseFormatter> chain;
+
+        for (std::string message : {"", "h", "hello world", "a longer message with 'quotes' & [brackets]"})
+        {
+            const std::string expected = UpperCaseFormatter{}.format(Timestamp{}.format(CapitalizeFormatter{}.format(message)));
+
+            REQUIRE(chain.format(message) == expected);
+
+            chain.format_in_place(message);
+            REQUIRE(message == expected);
+        }
+    }
+
+    SECTION("format_to reuses capacity of a buffer")
+    {
+        const FormatterChain<CapitalizeFormatter, Timestamp, UpperCaseFormatter> chain;
+        std::string buffer;
+        buffer.reserve(64);
+
+        const auto allocations_before = Helpers::AllocationCounter::allocations;
+        chain.format_to("a log message longer than small string buffer", buffer);
+        REQUIRE(Helpers::AllocationCounter::allocations == allocations_before);
+
+        REQUIRE(buffer == "[13:05:09.042] A LOG MESSAGE LONGER THAN SMALL STRING BUFFER");
+    }
+
+    SECTION("chain as a formatter of Logger")
+    {
+        using Chain = FormatterChain<InfoPrefix, CapitalizeFormatter>;
+        static_assert(BufferFormatter<Chain> && InPlaceFormatter<Chain>);
+
+        std::ostringstream out;
+        CoutRedirect redirect{out.rdbuf()};
+
+        Logger<Chain> logger;
+        logger.log("started");
+        logger.log(std::string{"stopped"});
+
+        REQUIRE(out.str() == "Info: started\nInfo: stopped\n");
+    }
+}
+
+TEST_CASE("formatter chains - fused vs sequential", "[.][benchmark]")
+{
+    const CapitalizeFormatter capitalize;
+    const TimestampFormatter<> timestamp;
+    const UpperCaseFormatter upper_case;
+    const FormatterChain<CapitalizeFormatter, TimestampFormatter<>, UpperCaseFormatter> chain;
+
+    for (std::size_t size : {16u, 64u, 256u, 1024u, 4096u})
+    {
+        const std::string message(size, 'x');
+        const std::string suffix = " - size: " + std::to_string(size);
+
+        BENCHMARK("sequential - format()" + suffix)
+        {
+            return upper_case.format(timestamp.format(capitalize.format(message)));
+        };
+
+        BENCHMARK_ADVANCED("sequential - format_to() + format_in_place()" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::string buffer;
+            meter.measure([&] {
+                capitalize.format_to(message, buffer);
+                timestamp.format_in_place(buffer);
+                upper_case.format_in_place(buffer);
+                return buffer.size();
+            });
+        };
+
+        BENCHMARK("fused - format()" + suffix)
+        {
+            return chain.format(message);
+        };
+
+        BENCHMARK_ADVANCED("fused - format_to()" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::string buffer;
+            meter.measure([&] {
+                chain.format_to(message, buffer);
+                return buffer.size();
+            });
+        };
+    }
+}
+
+namespace
+{
+    // stream buffer that blocks the first write until it is opened - stalls the consumer of AsyncLogger
+    class GateBuffer : public std::streambuf
+    {
+        std::string text_;
+        std::atomic<bool> open_{false};
+        std::atomic<bool> writer_waiting_{false};
+
+    protected:
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            writer_waiting_ = true;
+            writer_waiting_.notify_all();
+            open_.wait(false);
+
+            text_.append(s, n);
+            return n;
+        }
+
+        int_type overflow(int_type ch) override
+        {
+            char c = traits_type::to_char_type(ch);
+            return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+        }
+
+    public:
+        void wait_for_writer()
+        {
+            writer_waiting_.wait(false);
+        }
+
+        void open()
+        {
+            open_ = true;
+            open_.notify_all();
+        }
+
+        const std::string& text() const
+        {
+            return text_;
+        }
+    };
+
+    // stream buffer that remembers the last index written by each producer - lines are "<producer> <index>"
+    template <int ProducersCount>
+    class ProgressBuffer : public std::streambuf
+    {
+        std::string line_;
+        std::array<std::atomic<int>, ProducersCount> last_index_{};
+
+    protected:
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            for (std::streamsize i = 0; i < n; ++i)
+                overflow(traits_type::to_int_type(s[i]));
+            return n;
+        }
+
+        int_type overflow(int_type ch) override
+        {
+            if (const char c = traits_type::to_char_type(ch); c != '\n')
+            {
+                line_ += c;
+            }
+            else
+            {
+                std::istringstream in{line_};
+                int producer, index;
+                in >> producer >> index;
+                last_index_[producer].store(index, std::memory_order_relaxed);
+                line_.clear();
+            }
+
+            return ch;
+        }
+
+    public:
+        ProgressBuffer()
+        {
+            for (auto& index : last_index_)
+                index.store(-1, std::memory_order_relaxed);
+        }
+
+        int last_index(int producer) const
+        {
+            return last_index_[producer].load(std::memory_order_relaxed);
+        }
+    };
+} // namespace
+
+TEST_CASE("async logger")
+{
+    using namespace Logging;
+
+    SECTION("messages are formatted & written in order")
+    {
+        std::ostringstream out;
+
+        {
+            AsyncLogger<UpperCaseFormatter> logger{out};
+            logger.log("hello");
+            logger.log("world");
+            logger.log("");
+            logger.flush();
+
+            REQUIRE(out.str() == "HELLO\nWORLD\n\n");
+        }
+    }
+
+    SECTION("pending messages are written by destructor")
+    {
+        std::ostringstream out;
+
+        {
+            AsyncLogger<CapitalizeFormatter> logger{out};
+            for (int i = 0; i < 100; ++i)
+                logger.log("message");
+        }
+
+        REQUIRE(std::ranges::count(out.str(), '\n') == 100);
+    }
+
+    SECTION("many producers - block")
+    {
+        std::ostringstream out;
+        constexpr int producers_count = 8;
+        constexpr int messages_per_producer = 1'000;
+
+        {
+            AsyncLogger<UpperCaseFormatter, Block> logger{out, 16};
+
+            std::vector<std::jthread> producers;
+            for (int p = 0; p < producers_count; ++p)
+            {
+                producers.emplace_back([&logger] {
+                    for (int i = 0; i < messages_per_producer; ++i)
+                        logger.log("message " + std::to_string(i));
+                });
+            }
+            producers.clear();
+
+            logger.flush();
+            REQUIRE(logger.lost() == 0);
+        }
+
+        REQUIRE(std::ranges::count(out.str(), '\n') == producers_count * messages_per_producer);
+    }
+
+    SECTION("many producers - flush waits for own messages")
+    {
+        constexpr int producers_count = 4;
+        constexpr int messages_per_producer = 500;
+
+        ProgressBuffer<producers_count> progress;
+        std::ostream out{&progress};
+        std::atomic<int> failures{0};
+
+        {
+            AsyncLogger<UpperCaseFormatter, Block> logger{out, 16};
+
+            std::vector<std::jthread> producers;
+            for (int p = 0; p < producers_count; ++p)
+            {
+                producers.emplace_back([&, p] {
+                    for (int i = 0; i < messages_per_producer; ++i)
+                    {
+                        logger.log(std::to_string(p) + " " + std::to_string(i));
+                        logger.flush();
+
+                        if (progress.last_index(p) != i)
+                            ++failures;
+                    }
+                });
+            }
+        }
+
+        REQUIRE(failures == 0);
+    }
+
+    SECTION("overflow")
+    {
+        GateBuffer gate;
+        std::ostream out{&gate};
+
+        const auto log_while_consumer_is_stalled = [&gate](auto& logger) {
+            logger.log("m0");
+            gate.wait_for_writer(); // m0 was taken from the queue
+
+            for (int i = 1; i < 10; ++i)
+                logger.log("m" + std::to_string(i));
+
+            gate.open();
+            logger.flush();
+        };
+
+        SECTION("drop - new messages are lost")
+        {
+            AsyncLogger<UpperCaseFormatter, Drop> logger{out, 4};
+            log_while_consumer_is_stalled(logger);
+
+            REQUIRE(logger.lost() == 5);
+            REQUIRE(gate.text() == "M0\nM1\nM2\nM3\nM4\n");
+        }
+
+        SECTION("overwrite - the oldest messages are lost")
+        {
+            AsyncLogger<UpperCaseFormatter, Overwrite> logger{out, 4};
+            log_while_consumer_is_stalled(logger);
+
+            REQUIRE(logger.lost() == 5);
+            REQUIRE(gate.text() == "M0\nM6\nM7\nM8\nM9\n");
+        }
+    }
+}
+
+TEST_CASE("async logger - producers", "[.][benchmark]")
+{
+    constexpr int messages_per_producer = 1'000;
+
+    NullBuffer null_buffer;
+    std::ostream null_out{&null_buffer};
+
+    const auto run_producers = [](unsigned producers_count, auto log) {
+        std::vector<std::jthread> producers;
+        for (unsigned p = 0; p < producers_count; ++p)
+        {
+            producers.emplace_back([log] {
+                for (int i = 0; i < messages_per_producer; ++i)
+                    log("log message from a producer thread");
+            });
+        }
+    };
+
+    for (unsigned producers_count : {1u, 2u, 4u, 8u, 16u, 32u})
+    {
+        const std::string suffix = " - producers: " + std::to_string(producers_count);
+
+        BENCHMARK_ADVANCED("sync Logger - std::endl" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::streambuf* cout_buffer = std::cout.rdbuf(&null_buffer);
+
+            Logger<UpperCaseFormatter> logger;
+            meter.measure([&] {
+                run_producers(producers_count, [&logger](const std::string& message) { logger.log(message); });
+            });
+
+            std::cout.rdbuf(cout_buffer);
+        };
+
+        // latency of log() - the consumer works in the background
+        BENCHMARK_ADVANCED("AsyncLogger - log()" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            Logging::AsyncLogger<UpperCaseFormatter> logger{null_out, 64 * 1024};
+            meter.measure([&] {
+                run_producers(producers_count, [&logger](const std::string& message) { logger.log(message); });
+            });
+            logger.flush();
+        };
+
+        // throughput - until all messages are written
+        BENCHMARK_ADVANCED("AsyncLogger - log() + flush()" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            Logging::AsyncLogger<UpperCaseFormatter> logger{null_out};
+            meter.measure([&] {
+                run_producers(producers_count, [&logger](const std::string& message) { logger.log(message); });
+                logger.flush();
+            });
+        };
+    }
+}
+
+/////////////////////////////////////////////////////////////////
+// RangeCheckPolicy
+//
+class ThrowingRangeChecker
+{
+public:
+    static constexpr bool index_valid_after_check = true;
+
+protected:
+    ~ThrowingRangeChecker() = default;
+
+    void check_range(size_t index, size_t size) const
+    {
+        if (index >= size)
+            throw std::out_of_range("Index out of range...");
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+// RangeCheckPolicy
+//
+class LoggingErrorRangeChecker
+{
+public:
+    void set_log_file(std::ostream& log_file)
+    {
+        log_ = &log_file;
+    }
+
+protected:
+    ~LoggingErrorRangeChecker() = default;
+
+    void check_range(size_t index, size_t size) const
+    {
+        if ((index >= size) && (log_ != nullptr))
+            *log_ << "Error: Index out of range. Index="
+                  << index << "; Size=" << size << std::endl;
+        
+        //std::terminate();
+    }
+
+private:
+    std::ostream* log_{};
+};
+
+/////////////////////////////////////////////////////////////////
+// RangeCheckPolicy - index is not checked; at() is a plain indexed load
+//
+class NoRangeCheck
+{
+public:
+    static constexpr bool index_valid_after_check = true; // assumed
+
+protected:
+    ~NoRangeCheck() = default;
+
+    void check_range(size_t, size_t) const noexcept
+    {
+    }
+};
+
+// true if at() may skip the fallback for an invalid index - check_range() throws or
+// the index is assumed to be valid
+template <typename TRangeCheckPolicy>
+constexpr bool is_index_valid_after_check_v = requires { requires TRangeCheckPolicy::index_valid_after_check; };
+
+/////////////////////////////////////////////////////////////////
+// RangeCheckPolicy - selected by build type
+//
+#ifdef NDEBUG
+using DefaultRangeChecker = NoRangeCheck;
+#else
+using DefaultRangeChecker = ThrowingRangeChecker;
+#endif
+
+/////////////////////////////////////////////////////////////////
+// LockingPolicy
+//
+class NullMutex
+{
+public:
+    void lock()
+    {
+    }
+
+    void unlock()
+    {
     }
 };
 
-TEST_CASE("static polymorphism")
-{   
-    Logger<CapitalizeFormatter> logger_1;
-    logger_1.log("hello");
+/////////////////////////////////////////////////////////////////
+// LockingPolicy
+//
+using StdMutex = std::mutex;
 
-    Logger<> logger_2;
-    logger_2.log("world");
+/////////////////////////////////////////////////////////////////
+// LockingPolicy - const operations of Vector take shared locks
+//
+using SharedMutex = std::shared_mutex;
 
-    Logger logger_3{CapitalizeFormatter{}};
-    logger_3.log("ctad");
+inline void cpu_relax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
 }
 
 /////////////////////////////////////////////////////////////////
-// RangeCheckPolicy
+// LockingPolicy - spinlock with exponential backoff
 //
-class ThrowingRangeChecker
+class SpinLock
 {
-protected:
-    ~ThrowingRangeChecker() = default;
+    static constexpr unsigned max_backoff = 1024;
 
-    void check_range(size_t index, size_t size) const
+    std::atomic<bool> locked_{false};
+
+public:
+    void lock() noexcept
     {
-        if (index >= size)
-            throw std::out_of_range("Index out of range...");
+        unsigned backoff = 1;
+
+        while (locked_.exchange(true, std::memory_order_acquire))
+        {
+            // waits with plain loads - the cache line is not bounced between cores
+            while (locked_.load(std::memory_order_relaxed))
+            {
+                if (backoff < max_backoff)
+                {
+                    for (unsigned i = 0; i < backoff; ++i)
+                        cpu_relax();
+                    backoff *= 2;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept
+    {
+        locked_.store(false, std::memory_order_release);
     }
 };
 
 /////////////////////////////////////////////////////////////////
-// RangeCheckPolicy
+// LockingPolicy - seqlock for read-mostly data; writers are exclusive,
+// readers do not write shared memory - they retry if a write overlapped the read
 //
-class LoggingErrorRangeChecker
+class SeqLock
 {
+    std::atomic<std::uint64_t> sequence_{0};
+    SpinLock writer_mtx_;
+
 public:
-    void set_log_file(std::ostream& log_file)
+    void lock() noexcept
     {
-        log_ = &log_file;
+        writer_mtx_.lock();
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // odd - write in progress
+        std::atomic_thread_fence(std::memory_order_release);
     }
 
-protected:
-    ~LoggingErrorRangeChecker() = default;
+    void unlock() noexcept
+    {
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        writer_mtx_.unlock();
+    }
 
-    void check_range(size_t index, size_t size) const
+    std::uint64_t read_begin() const noexcept
     {
-        if ((index >= size) && (log_ != nullptr))
-            *log_ << "Error: Index out of range. Index="
-                  << index << "; Size=" << size << std::endl;
-        
-        //std::terminate();
+        std::uint64_t sequence;
+        for (unsigned spins = 0; (sequence = sequence_.load(std::memory_order_acquire)) & 1; ++spins)
+        {
+            if (spins < 64)
+                cpu_relax();
+            else
+                std::this_thread::yield(); // writer may be preempted
+        }
+
+        return sequence;
     }
 
-private:
-    std::ostream* log_{};
+    bool read_retry(std::uint64_t sequence) const noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) != sequence;
+    }
 };
 
 /////////////////////////////////////////////////////////////////
-// LockingPolicy
+// locking of const operations - selected at compile time
 //
-class NullMutex
+enum class ReadLocking
+{
+    exclusive,
+    shared,
+    optimistic
+};
+
+template <typename TMutex>
+constexpr ReadLocking read_locking_v = []{
+    if constexpr (requires(const TMutex& m, std::uint64_t seq) { m.read_begin(); m.read_retry(seq); })
+        return ReadLocking::optimistic;
+    else if constexpr (requires(TMutex& m) { m.lock_shared(); m.unlock_shared(); })
+        return ReadLocking::shared;
+    else
+        return ReadLocking::exclusive;
+}();
+
+////////////////////////////////////////////////////////////////
+// state of Vector needed only by optimistic readers - a snapshot of the items published
+// by writers; buffers replaced by growth are kept alive, so a reader never touches freed memory
+// (capacity doubles, so retired buffers together are smaller than the current one)
+template <typename T>
+class OptimisticSnapshot
 {
+    std::atomic<const T*> data_{};
+    std::atomic<size_t> size_{};
+    std::vector<std::vector<T>> retired_buffers_;
+
 public:
-    void lock()
+    const T* data() const noexcept
     {
+        return data_.load(std::memory_order_acquire);
     }
 
-    void unlock()
+    size_t size() const noexcept
+    {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    void publish(const std::vector<T>& items) noexcept
     {
+        data_.store(items.data(), std::memory_order_release);
+        size_.store(items.size(), std::memory_order_release);
+    }
+
+    // items are copied to a new buffer if count items do not fit - the old one is retired
+    void reserve(std::vector<T>& items, size_t count)
+    {
+        if (items.capacity() - items.size() < count)
+        {
+            std::vector<T> grown;
+            grown.reserve(std::max(2 * items.capacity(), items.size() + count));
+            grown.assign(items.begin(), items.end());
+
+            retired_buffers_.push_back(std::move(items));
+            items = std::move(grown);
+        }
     }
 };
 
-/////////////////////////////////////////////////////////////////
-// LockingPolicy
-//
-using StdMutex = std::mutex;
+// locking policies without optimistic reads need no snapshot
+struct NoSnapshot
+{
+    template <typename TItems>
+    void publish(const TItems&) noexcept
+    {
+    }
+
+    template <typename TItems>
+    void reserve(TItems&, size_t)
+    {
+    }
+};
 
-////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 template <
     typename T,
-    typename RangeCheckPolicy,
+    typename RangeCheckPolicy = DefaultRangeChecker,
     typename LockingPolicy = NullMutex>
 class Vector : public RangeCheckPolicy
 {
-    std::vector<T> items_;
     using mutex_type = LockingPolicy;
+    static constexpr ReadLocking read_locking = read_locking_v<LockingPolicy>;
+    static constexpr bool optimistic_reads = read_locking == ReadLocking::optimistic;
+
+    static_assert(!optimistic_reads || std::is_trivially_copyable_v<T>, "Optimistic reads require trivially copyable items");
+
+    std::vector<T> items_;
     mutable mutex_type mtx_;
+    [[no_unique_address]] std::conditional_t<optimistic_reads, OptimisticSnapshot<T>, NoSnapshot> snapshot_;
+
+    // optimistic readers may race with a writer - items are read atomically
+    static T load(const T& item)
+    {
+        if constexpr (optimistic_reads)
+            return std::atomic_ref<T>(const_cast<T&>(item)).load(std::memory_order_relaxed);
+        else
+            return item;
+    }
+
+    // calls reader(data, size) under a lock selected by read_locking
+    template <typename TReader>
+    decltype(auto) read(TReader reader) const
+    {
+        if constexpr (read_locking == ReadLocking::optimistic)
+        {
+            while (true)
+            {
+                const std::uint64_t sequence = mtx_.read_begin();
+                // size is loaded first - a buffer published before it holds at least size items
+                const size_t size = snapshot_.size();
+                auto result = reader(snapshot_.data(), size);
+                if (!mtx_.read_retry(sequence))
+                    return result;
+            }
+        }
+        else if constexpr (read_locking == ReadLocking::shared)
+        {
+            std::shared_lock lk{mtx_};
+            return reader(items_.data(), items_.size());
+        }
+        else
+        {
+            std::lock_guard<mutex_type> lk{mtx_};
+            return reader(items_.data(), items_.size());
+        }
+    }
+
+    // lock of the const locked view - readers share it if the policy allows
+    using read_lock_type = std::conditional_t<read_locking == ReadLocking::shared,
+        std::shared_lock<mutex_type>, std::unique_lock<mutex_type>>;
 
 public:
+    using range_check_policy = RangeCheckPolicy;
+    using locking_policy = LockingPolicy;
+
+    // items are returned by value if Vector can be modified concurrently
+    // (a reference would outlive the lock)
+    using const_reference = std::conditional_t<std::is_same_v<LockingPolicy, NullMutex>, const T&, T>;
+
     Vector() = default;
 
     template <typename U>
     Vector(std::initializer_list<U> il)
         : items_{il}
     {
+        snapshot_.publish(items_);
     }
 
     bool empty() const
     {
-        std::lock_guard<mutex_type> lk{mtx_};
-        return items_.empty();
+        return read([](const T*, size_t size) { return size == 0; });
     }
 
     size_t size() const
     {
-        std::lock_guard<mutex_type> lk{mtx_};
-        return items_.size();
+        return read([](const T*, size_t size) { return size; });
     }
 
-
-    const T& at(size_t index) const
+    const_reference at(size_t index) const
     {
-        std::lock_guard<mutex_type> lk{mtx_};
+        if constexpr (optimistic_reads)
+        {
+            // range is checked on a consistent snapshot
+            auto [item, size] = read([index](const T* data, size_t size) {
+                return std::pair{(index < size) ? load(data[index]) : T{}, size};
+            });
+
+            RangeCheckPolicy::check_range(index, size);
 
-        RangeCheckPolicy::check_range(index, items_.size());
+            return item;
+        }
+        else
+        {
+            return read([this, index](const T* data, size_t size) -> const_reference {
+                RangeCheckPolicy::check_range(index, size);
 
-        return (index >= items_.size()) ? items_.back() : items_[index];
+                if constexpr (is_index_valid_after_check_v<RangeCheckPolicy>)
+                    return data[index];
+                else
+                    return (index >= size) ? data[size - 1] : data[index];
+            });
+        }
     }
 
     void push_back(const T& item)
     {
         std::lock_guard<mutex_type> lk{mtx_};
 
+        snapshot_.reserve(items_, 1);
         items_.push_back(item);
+        snapshot_.publish(items_);
+    }
+
+    // appends all items of a range under a single lock
+    // (views that are not const-iterable or end with a sentinel are accepted)
+    template <std::ranges::forward_range TRange>
+    void push_back_range(TRange&& range)
+    {
+        std::lock_guard<mutex_type> lk{mtx_};
+
+        snapshot_.reserve(items_, static_cast<size_t>(std::ranges::distance(range)));
+        auto common_range = std::views::common(std::forward<TRange>(range));
+        items_.insert(items_.end(), std::ranges::begin(common_range), std::ranges::end(common_range));
+        snapshot_.publish(items_);
+    }
+
+    // calls f(item) for every item under a single lock
+    template <typename TFunction>
+    void for_each(TFunction f) const
+    {
+        read_lock_type lk{mtx_};
+
+        for (const T& item : items_)
+            f(item);
+    }
+
+    template <typename TFunction>
+    void for_each(TFunction f) requires (!optimistic_reads) // optimistic readers would race with f
+    {
+        std::lock_guard<mutex_type> lk{mtx_};
+
+        for (T& item : items_)
+            f(item);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // handle that holds the lock of Vector as long as it lives - iterators are valid
+    // for the lifetime of the handle
+    template <typename TItems, typename TLock>
+    class LockedView
+    {
+        TLock lk_;
+        TItems& items_;
+
+    public:
+        LockedView(TItems& items, mutex_type& mtx)
+            : lk_{mtx}
+            , items_{items}
+        {
+        }
+
+        auto begin() const
+        {
+            return items_.begin();
+        }
+
+        auto end() const
+        {
+            return items_.end();
+        }
+
+        size_t size() const
+        {
+            return items_.size();
+        }
+
+        decltype(auto) operator[](size_t index) const
+        {
+            return items_[index];
+        }
+    };
+
+    auto locked() requires (!optimistic_reads)
+    {
+        return LockedView<std::vector<T>, std::unique_lock<mutex_type>>{items_, mtx_};
+    }
+
+    auto locked() const
+    {
+        return LockedView<const std::vector<T>, read_lock_type>{items_, mtx_};
     }
 };
 
@@ -178,4 +1414,376 @@ TEST_CASE("using policies - Policy Based Design")
     vec_2.set_log_file(str_out);
     vec_2.at(10);
     std::cout << str_out.str() << "\n";
-}
\ No newline at end of file
+}
+
+TEST_CASE("locking policies")
+{
+    static_assert(read_locking_v<NullMutex> == ReadLocking::exclusive);
+    static_assert(read_locking_v<StdMutex> == ReadLocking::exclusive);
+    static_assert(read_locking_v<SpinLock> == ReadLocking::exclusive);
+    static_assert(read_locking_v<SharedMutex> == ReadLocking::shared);
+    static_assert(read_locking_v<SeqLock> == ReadLocking::optimistic);
+
+    // only optimistic readers pay for the snapshot
+    static_assert(sizeof(Vector<int, NoRangeCheck, StdMutex>) == sizeof(std::vector<int>) + sizeof(std::mutex));
+    static_assert(std::is_copy_constructible_v<Vector<int, NoRangeCheck>>);
+    static_assert(std::is_same_v<decltype(std::declval<const Vector<int, NoRangeCheck>&>().at(0)), const int&>);
+    static_assert(std::is_same_v<decltype(std::declval<const Vector<int, NoRangeCheck, SharedMutex>&>().at(0)), int>);
+    static_assert(std::is_same_v<decltype(std::declval<const Vector<int, NoRangeCheck, SeqLock>&>().at(0)), int>);
+
+    SECTION("shared mutex")
+    {
+        Vector<int, ThrowingRangeChecker, SharedMutex> vec = {1, 2, 3};
+        vec.push_back(4);
+
+        REQUIRE(vec.size() == 4);
+        REQUIRE(vec.at(3) == 4);
+        REQUIRE_THROWS_AS(vec.at(4), std::out_of_range);
+    }
+
+    SECTION("seqlock")
+    {
+        Vector<int, ThrowingRangeChecker, SeqLock> vec;
+        REQUIRE(vec.empty());
+
+        for (int i = 0; i < 100; ++i)
+            vec.push_back(i);
+
+        REQUIRE(vec.size() == 100);
+        REQUIRE(vec.at(42) == 42);
+        REQUIRE_THROWS_AS(vec.at(100), std::out_of_range);
+    }
+}
+
+namespace
+{
+    // readers check that every item they see is consistent with its index
+    template <typename TLockingPolicy>
+    bool read_while_writing(int readers_count, int items_count)
+    {
+        Vector<int, ThrowingRangeChecker, TLockingPolicy> vec = {0};
+        std::atomic<bool> consistent{true};
+
+        {
+            std::vector<std::jthread> threads;
+            for (int r = 0; r < readers_count; ++r)
+            {
+                threads.emplace_back([&vec, &consistent, items_count] {
+                    for (int i = 0; i < items_count; ++i)
+                    {
+                        const size_t index = vec.size() - 1;
+                        if (vec.at(index) != static_cast<int>(index))
+                            consistent = false;
+                    }
+                });
+            }
+
+            threads.emplace_back([&vec, items_count] {
+                for (int i = 1; i < items_count; ++i)
+                    vec.push_back(i);
+            });
+        }
+
+        return consistent && vec.size() == static_cast<size_t>(items_count);
+    }
+} // namespace
+
+TEST_CASE("locking policies - concurrent readers & writer")
+{
+    REQUIRE(read_while_writing<StdMutex>(4, 10'000));
+    REQUIRE(read_while_writing<SharedMutex>(4, 10'000));
+    REQUIRE(read_while_writing<SpinLock>(4, 10'000));
+    REQUIRE(read_while_writing<SeqLock>(4, 10'000));
+}
+
+namespace
+{
+    // each reader does reads_per_thread at() calls; a single writer appends an item every 1000 reads
+    template <typename TLockingPolicy>
+    int read_heavy(unsigned readers_count, int reads_per_thread)
+    {
+        Vector<int, ThrowingRangeChecker, TLockingPolicy> vec = {1, 2, 3, 4, 5, 6, 7, 8};
+        std::atomic<int> checksum{0};
+
+        std::vector<std::jthread> threads;
+        threads.emplace_back([&vec, reads_per_thread] {
+            for (int i = 0; i < reads_per_thread / 1'000; ++i)
+            {
+                vec.push_back(i);
+                std::this_thread::yield();
+            }
+        });
+
+        for (unsigned r = 0; r < readers_count; ++r)
+        {
+            threads.emplace_back([&vec, &checksum, reads_per_thread] {
+                int sum = 0;
+                for (int i = 0; i < reads_per_thread; ++i)
+                    sum += vec.at(i % 8);
+                checksum += sum;
+            });
+        }
+
+        threads.clear(); // joins
+
+        return checksum;
+    }
+} // namespace
+
+TEST_CASE("locking policies - read-heavy", "[.][benchmark]")
+{
+    constexpr int reads_per_thread = 100'000;
+
+    for (unsigned readers_count : {1u, 4u, 16u})
+    {
+        const std::string suffix = " - readers: " + std::to_string(readers_count);
+
+        BENCHMARK("StdMutex" + suffix)
+        {
+            return read_heavy<StdMutex>(readers_count, reads_per_thread);
+        };
+
+        BENCHMARK("SharedMutex" + suffix)
+        {
+            return read_heavy<SharedMutex>(readers_count, reads_per_thread);
+        };
+
+        BENCHMARK("SpinLock" + suffix)
+        {
+            return read_heavy<SpinLock>(readers_count, reads_per_thread);
+        };
+
+        BENCHMARK("SeqLock" + suffix)
+        {
+            return read_heavy<SeqLock>(readers_count, reads_per_thread);
+        };
+    }
+}
+
+TEST_CASE("range check policies")
+{
+    static_assert(is_index_valid_after_check_v<NoRangeCheck>);
+    static_assert(is_index_valid_after_check_v<ThrowingRangeChecker>);
+    static_assert(!is_index_valid_after_check_v<LoggingErrorRangeChecker>);
+
+    SECTION("default policy depends on build type")
+    {
+#ifdef NDEBUG
+        REQUIRE(std::is_same_v<Vector<int>::range_check_policy, NoRangeCheck>);
+#else
+        REQUIRE(std::is_same_v<Vector<int>::range_check_policy, ThrowingRangeChecker>);
+        Vector<int> vec = {1, 2, 3};
+        REQUIRE_THROWS_AS(vec.at(3), std::out_of_range);
+#endif
+    }
+
+    SECTION("NoRangeCheck")
+    {
+        Vector<int, NoRangeCheck> vec = {1, 2, 3};
+
+        REQUIRE(vec.at(2) == 3);
+    }
+
+    SECTION("LoggingErrorRangeChecker - invalid index is logged & the last item is returned")
+    {
+        std::stringstream log;
+        Vector<int, LoggingErrorRangeChecker> vec = {1, 2, 3};
+        vec.set_log_file(log);
+
+        REQUIRE(vec.at(10) == 3);
+        REQUIRE(log.str() == "Error: Index out of range. Index=10; Size=3\n");
+    }
+}
+
+namespace
+{
+    template <typename TRangeCheckPolicy>
+    long sum_with_at(const Vector<int, TRangeCheckPolicy>& vec)
+    {
+        long sum = 0;
+        for (size_t i = 0; i < vec.size(); ++i)
+            sum += vec.at(i);
+
+        return sum;
+    }
+} // namespace
+
+TEST_CASE("range check policies - at()", "[.][benchmark]")
+{
+    Vector<int, NoRangeCheck> unchecked;
+    Vector<int, ThrowingRangeChecker> throwing;
+    Vector<int, LoggingErrorRangeChecker> logging;
+
+    for (int i = 0; i < 100'000; ++i)
+    {
+        unchecked.push_back(i);
+        throwing.push_back(i);
+        logging.push_back(i);
+    }
+
+    BENCHMARK("NoRangeCheck")
+    {
+        return sum_with_at(unchecked);
+    };
+
+    BENCHMARK("ThrowingRangeChecker")
+    {
+        return sum_with_at(throwing);
+    };
+
+    BENCHMARK("LoggingErrorRangeChecker")
+    {
+        return sum_with_at(logging);
+    };
+}
+
+TEST_CASE("batch operations")
+{
+    SECTION("push_back_range")
+    {
+        Vector<int, ThrowingRangeChecker, StdMutex> vec = {1};
+
+        const std::vector<int> items = {2, 3, 4};
+        vec.push_back_range(items);
+
+        REQUIRE(vec.size() == 4);
+        REQUIRE(vec.at(3) == 4);
+    }
+
+    SECTION("push_back_range - seqlock grows the buffer once")
+    {
+        Vector<int, ThrowingRangeChecker, SeqLock> vec = {0};
+
+        vec.push_back_range(std::views::iota(1, 100));
+
+        REQUIRE(vec.size() == 100);
+        REQUIRE(vec.at(99) == 99);
+    }
+
+    SECTION("push_back_range - filtered view")
+    {
+        Vector<int, ThrowingRangeChecker, StdMutex> vec;
+
+        std::vector<int> items = {1, 2, 3, 4, 5, 6, 7, 8};
+        auto is_even = [](int x) { return x % 2 == 0; };
+        vec.push_back_range(items | std::views::filter(is_even)); // not const-iterable
+        vec.push_back_range(std::views::iota(1) | std::views::filter(is_even) | std::views::take(2)); // end is a sentinel
+
+        REQUIRE(vec.size() == 6);
+        REQUIRE(vec.at(3) == 8);
+        REQUIRE(vec.at(5) == 4);
+    }
+
+    SECTION("for_each")
+    {
+        Vector<int, ThrowingRangeChecker, SharedMutex> vec = {1, 2, 3};
+
+        int sum = 0;
+        std::as_const(vec).for_each([&sum](int x) { sum += x; });
+        REQUIRE(sum == 6);
+
+        vec.for_each([](int& x) { x *= 10; });
+        REQUIRE(vec.at(2) == 30);
+    }
+
+    SECTION("locked view")
+    {
+        Vector<int, ThrowingRangeChecker, StdMutex> vec = {3, 1, 2};
+
+        {
+            auto view = vec.locked();
+            std::sort(view.begin(), view.end());
+            REQUIRE(view[0] == 1);
+        }
+
+        const auto& const_vec = vec;
+        auto view = const_vec.locked();
+        REQUIRE(std::accumulate(view.begin(), view.end(), 0) == 6);
+        REQUIRE(std::is_sorted(view.begin(), view.end()));
+    }
+
+    SECTION("const locked view - readers share the lock")
+    {
+        Vector<int, ThrowingRangeChecker, SharedMutex> vec = {1, 2, 3};
+
+        const auto& const_vec = vec;
+        auto view = const_vec.locked();
+
+        auto size = std::async(std::launch::async, [&vec] { return vec.size(); });
+        REQUIRE(size.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        REQUIRE(size.get() == view.size());
+    }
+}
+
+namespace
+{
+    template <typename TPush>
+    size_t produce(unsigned producers_count, TPush push)
+    {
+        Vector<int, ThrowingRangeChecker, StdMutex> vec;
+
+        {
+            std::vector<std::jthread> producers;
+            for (unsigned p = 0; p < producers_count; ++p)
+                producers.emplace_back([&vec, push] { push(vec); });
+        }
+
+        return vec.size();
+    }
+} // namespace
+
+TEST_CASE("batch operations - StdMutex", "[.][benchmark]")
+{
+    constexpr int items_per_producer = 10'000;
+    constexpr int batch_size = 256;
+
+    std::vector<int> batch(batch_size);
+    std::iota(batch.begin(), batch.end(), 0);
+
+    for (unsigned producers_count : {1u, 4u})
+    {
+        const std::string suffix = " - producers: " + std::to_string(producers_count);
+
+        BENCHMARK("push_back" + suffix)
+        {
+            return produce(producers_count, [](auto& vec) {
+                for (int i = 0; i < items_per_producer; ++i)
+                    vec.push_back(i);
+            });
+        };
+
+        BENCHMARK("push_back_range" + suffix)
+        {
+            return produce(producers_count, [&batch](auto& vec) {
+                for (int i = 0; i < items_per_producer; i += batch_size)
+                    vec.push_back_range(batch);
+            });
+        };
+    }
+
+    Vector<int, ThrowingRangeChecker, StdMutex> vec;
+    for (int i = 0; i < 100'000; ++i)
+        vec.push_back(i);
+
+    BENCHMARK("sum - at()")
+    {
+        long sum = 0;
+        for (size_t i = 0; i < vec.size(); ++i)
+            sum += vec.at(i);
+        return sum;
+    };
+
+    BENCHMARK("sum - for_each")
+    {
+        long sum = 0;
+        std::as_const(vec).for_each([&sum](int x) { sum += x; });
+        return sum;
+    };
+
+    BENCHMARK("sum - locked view")
+    {
+        const auto& const_vec = vec;
+        auto view = const_vec.locked();
+        return std::accumulate(view.begin(), view.end(), 0L);
+    };
+}